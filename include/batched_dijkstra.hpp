@@ -0,0 +1,129 @@
+#ifndef BATCHED_DIJKSTRA_HPP
+#define BATCHED_DIJKSTRA_HPP
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "melon/algorithm/dijkstra.hpp"
+#include "melon/container/static_digraph.hpp"
+
+/**
+ * @brief Dijkstra computing the distances from K sources in one traversal.
+ *
+ * Each vertex holds K distances, one lane per source, in a block aligned on
+ * its size so that the fixed length lane loops of an arc relaxation compile
+ * to AVX2 or AVX-512 add, compare and blend instructions (with
+ * OPTIMIZE_FOR_NATIVE). Vertices are settled in a shared order: the heap
+ * key of a vertex is the smallest of its lanes that improved since it was
+ * last scanned, and a vertex is scanned again whenever one of its lanes
+ * improves after being scanned.
+ */
+template <typename Graph, typename LengthMap, std::size_t K>
+class batched_dijkstra {
+public:
+    using vertex = fhamonic::melon::vertex_t<Graph>;
+    using arc = fhamonic::melon::arc_t<Graph>;
+    using value_t = std::decay_t<decltype(std::declval<const LengthMap &>()[
+        std::declval<arc>()])>;
+    struct alignas(K * sizeof(value_t)) lanes {
+        value_t lane[K];
+    };
+
+private:
+    using heap = fhamonic::melon::d_ary_heap<
+        4, vertex, value_t,
+        decltype([](const auto & e1, const auto & e2) {
+            return e1.second < e2.second;
+        }),
+        fhamonic::melon::vertex_map_t<Graph, std::size_t>>;
+
+    static constexpr value_t infinity = std::numeric_limits<value_t>::max();
+
+    std::reference_wrapper<const Graph> _graph;
+    std::reference_wrapper<const LengthMap> _length_map;
+    std::vector<lanes> _dist_map;
+    std::vector<char> _in_heap_map;
+    heap _heap;
+    std::size_t _nb_scans;
+
+public:
+    [[nodiscard]] batched_dijkstra(const Graph & g, const LengthMap & l)
+        : _graph(std::ref(g))
+        , _length_map(std::ref(l))
+        , _dist_map(g.nb_vertices())
+        , _in_heap_map(g.nb_vertices(), false)
+        , _heap(fhamonic::melon::create_vertex_map<std::size_t>(g))
+        , _nb_scans(0) {}
+
+    [[nodiscard]] static constexpr std::size_t nb_lanes() noexcept {
+        return K;
+    }
+    [[nodiscard]] std::size_t nb_scans() const noexcept { return _nb_scans; }
+    [[nodiscard]] value_t dist(const std::size_t lane,
+                               const vertex u) const noexcept {
+        return _dist_map[u].lane[lane];
+    }
+    [[nodiscard]] bool reached(const std::size_t lane,
+                               const vertex u) const noexcept {
+        return _dist_map[u].lane[lane] != infinity;
+    }
+
+private:
+    void update(const vertex v, const value_t key) {
+        if(_in_heap_map[v]) {
+            if(key < _heap.priority(v)) _heap.promote(v, key);
+            return;
+        }
+        _heap.push(v, key);
+        _in_heap_map[v] = true;
+    }
+
+public:
+    void run(const std::array<vertex, K> & sources) {
+        lanes infinities;
+        for(std::size_t i = 0; i < K; ++i) infinities.lane[i] = infinity;
+        for(auto & d : _dist_map) d = infinities;
+        _nb_scans = 0;
+
+        for(std::size_t i = 0; i < K; ++i) {
+            _dist_map[sources[i]].lane[i] = value_t{0};
+            update(sources[i], value_t{0});
+        }
+
+        const Graph & g = _graph.get();
+        const LengthMap & l = _length_map.get();
+        while(!_heap.empty()) {
+            const vertex u = _heap.top().first;
+            _heap.pop();
+            _in_heap_map[u] = false;
+            ++_nb_scans;
+
+            const lanes u_dist = _dist_map[u];
+            for(auto && a : g.out_arcs(u)) {
+                const vertex v = g.arc_target(a);
+                const value_t length = l[a];
+                lanes & v_dist = _dist_map[v];
+                lanes candidates;
+                bool any_improved = false;
+                for(std::size_t i = 0; i < K; ++i) {
+                    const value_t new_dist = u_dist.lane[i] + length;
+                    const bool improved = new_dist < v_dist.lane[i];
+                    any_improved |= improved;
+                    candidates.lane[i] = improved ? new_dist : infinity;
+                    v_dist.lane[i] = improved ? new_dist : v_dist.lane[i];
+                }
+                if(!any_improved) continue;
+                value_t key = candidates.lane[0];
+                for(std::size_t i = 1; i < K; ++i)
+                    key = candidates.lane[i] < key ? candidates.lane[i] : key;
+                update(v, key);
+            }
+        }
+    }
+};
+
+#endif  // BATCHED_DIJKSTRA_HPP
@@ -0,0 +1,236 @@
+#ifndef BETWEENNESS_CENTRALITY_HPP
+#define BETWEENNESS_CENTRALITY_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "melon/container/static_digraph.hpp"
+
+#include "dispatching_sssp.hpp"
+
+/**
+ * @brief Parallel betweenness centrality by Brandes' algorithm, exact or
+ * estimated from a sample of sources.
+ *
+ * Each source runs a breadth first search when the lengths are uniform and
+ * Dijkstra's algorithm otherwise, counting the shortest paths to every
+ * vertex, then accumulates the dependencies of the vertices in decreasing
+ * distance order, over the arcs u->v such that d(v) = d(u) + l(u,v). The
+ * lengths must be positive. The sources are taken by the threads from an
+ * atomic counter and each thread accumulates the dependencies in its own
+ * arrays, which are summed by slices of vertices once every source is done.
+ * A sample of k sources estimates the centralities by scaling the sums by
+ * n / k (Brandes and Pich).
+ */
+template <typename Graph, typename LengthMap,
+          length_class Class = length_class::unknown>
+class betweenness_centrality {
+public:
+    using vertex = fhamonic::melon::vertex_t<Graph>;
+    using arc = fhamonic::melon::arc_t<Graph>;
+    using value_t = std::decay_t<decltype(std::declval<const LengthMap &>()[
+        std::declval<arc>()])>;
+
+private:
+    static constexpr value_t infinity = std::numeric_limits<value_t>::max();
+
+    struct workspace {
+        std::vector<value_t> dist_map;
+        std::vector<double> nb_paths_map;
+        // (1 + dependency) / nb_paths of the vertices already accumulated
+        std::vector<double> coefficient_map;
+        std::vector<std::uint32_t> order;  // by nondecreasing distance
+        std::priority_queue<std::pair<value_t, std::uint32_t>,
+                            std::vector<std::pair<value_t, std::uint32_t>>,
+                            std::greater<>>
+            heap;
+        std::vector<double> centrality_map;
+
+        explicit workspace(const std::size_t n)
+            : dist_map(n, infinity)
+            , nb_paths_map(n, 0.0)
+            , coefficient_map(n, 0.0)
+            , centrality_map(n, 0.0) {
+            order.reserve(n);
+        }
+    };
+
+    std::size_t _nb_vertices;
+    std::size_t _nb_threads;
+    bool _unit_lengths;
+    std::vector<std::size_t> _out_begin;
+    std::vector<std::uint32_t> _out_neighbors;
+    std::vector<value_t> _out_lengths;  // empty for unit lengths
+    std::vector<workspace> _workspaces;
+    std::vector<double> _centrality_map;
+    std::atomic<std::size_t> _next_source;
+
+public:
+    [[nodiscard]] betweenness_centrality(const Graph & g, const LengthMap & l,
+                                         const std::size_t nb_threads)
+        : _nb_vertices(g.nb_vertices())
+        , _nb_threads(std::max(nb_threads, std::size_t{1}))
+        , _unit_lengths(Class == length_class::uniform)
+        , _out_begin(g.nb_vertices() + 1, 0)
+        , _out_neighbors(g.nb_arcs())
+        , _centrality_map(g.nb_vertices(), 0.0)
+        , _next_source(0) {
+        if constexpr(Class == length_class::unknown)
+            _unit_lengths = classify_lengths(g, l).first ==
+                            length_class::uniform;
+        if(!_unit_lengths) _out_lengths.resize(g.nb_arcs());
+        for(auto && u : g.vertices()) {
+            _out_begin[u + 1] = _out_begin[u];
+            for(auto && a : g.out_arcs(u)) {
+                assert(_unit_lengths || l[a] > value_t{0});
+                if(!_unit_lengths) _out_lengths[_out_begin[u + 1]] = l[a];
+                _out_neighbors[_out_begin[u + 1]++] =
+                    static_cast<std::uint32_t>(g.arc_target(a));
+            }
+        }
+        _workspaces.reserve(_nb_threads);
+        for(std::size_t t = 0; t < _nb_threads; ++t)
+            _workspaces.emplace_back(_nb_vertices);
+    }
+
+    [[nodiscard]] std::size_t nb_threads() const noexcept {
+        return _nb_threads;
+    }
+    [[nodiscard]] bool unit_lengths() const noexcept { return _unit_lengths; }
+    [[nodiscard]] double centrality(const vertex u) const noexcept {
+        return _centrality_map[u];
+    }
+
+    // Exact centralities, one search per vertex
+    void run() {
+        std::vector<vertex> sources(_nb_vertices);
+        for(std::size_t u = 0; u < _nb_vertices; ++u)
+            sources[u] = static_cast<vertex>(u);
+        run(sources);
+    }
+    // Centralities estimated from the given distinct sources
+    void run(std::span<const vertex> sources) {
+        _next_source.store(0, std::memory_order_relaxed);
+        const double scale =
+            sources.empty() ? 0.0
+                            : static_cast<double>(_nb_vertices) /
+                                  static_cast<double>(sources.size());
+        std::barrier sync(static_cast<std::ptrdiff_t>(_nb_threads));
+        auto work = [&](const std::size_t t) {
+            workspace & w = _workspaces[t];
+            std::fill(w.centrality_map.begin(), w.centrality_map.end(), 0.0);
+            for(;;) {
+                const std::size_t i =
+                    _next_source.fetch_add(1, std::memory_order_relaxed);
+                if(i >= sources.size()) break;
+                const auto s = static_cast<std::uint32_t>(sources[i]);
+                if(_unit_lengths)
+                    count_paths_bfs(w, s);
+                else
+                    count_paths_dijkstra(w, s);
+                accumulate(w, s);
+            }
+            sync.arrive_and_wait();
+            const std::size_t slice =
+                (_nb_vertices + _nb_threads - 1) / _nb_threads;
+            const std::size_t first = std::min(_nb_vertices, t * slice);
+            const std::size_t last = std::min(_nb_vertices, first + slice);
+            for(std::size_t u = first; u < last; ++u) {
+                double sum = 0.0;
+                for(const workspace & other : _workspaces)
+                    sum += other.centrality_map[u];
+                _centrality_map[u] = scale * sum;
+            }
+        };
+        std::vector<std::thread> threads;
+        for(std::size_t t = 1; t < _nb_threads; ++t)
+            threads.emplace_back(work, t);
+        work(0);
+        for(auto & thread : threads) thread.join();
+    }
+
+private:
+    void count_paths_bfs(workspace & w, const std::uint32_t s) {
+        w.dist_map[s] = value_t{0};
+        w.nb_paths_map[s] = 1.0;
+        w.order.push_back(s);
+        for(std::size_t head = 0; head < w.order.size(); ++head) {
+            const std::uint32_t u = w.order[head];
+            const value_t next_level = w.dist_map[u] + value_t{1};
+            for(std::size_t i = _out_begin[u]; i < _out_begin[u + 1]; ++i) {
+                const std::uint32_t v = _out_neighbors[i];
+                if(w.dist_map[v] == infinity) {
+                    w.dist_map[v] = next_level;
+                    w.order.push_back(v);
+                }
+                if(w.dist_map[v] == next_level)
+                    w.nb_paths_map[v] += w.nb_paths_map[u];
+            }
+        }
+    }
+
+    // lengths being positive, a vertex whose distance is reached again is
+    // not settled yet
+    void count_paths_dijkstra(workspace & w, const std::uint32_t s) {
+        w.dist_map[s] = value_t{0};
+        w.nb_paths_map[s] = 1.0;
+        w.heap.emplace(value_t{0}, s);
+        while(!w.heap.empty()) {
+            const auto [u_dist, u] = w.heap.top();
+            w.heap.pop();
+            if(u_dist != w.dist_map[u]) continue;  // outdated entry
+            w.order.push_back(u);
+            for(std::size_t i = _out_begin[u]; i < _out_begin[u + 1]; ++i) {
+                const std::uint32_t v = _out_neighbors[i];
+                const value_t new_dist = u_dist + _out_lengths[i];
+                if(new_dist < w.dist_map[v]) {
+                    w.dist_map[v] = new_dist;
+                    w.nb_paths_map[v] = w.nb_paths_map[u];
+                    w.heap.emplace(new_dist, v);
+                } else if(new_dist == w.dist_map[v]) {
+                    w.nb_paths_map[v] += w.nb_paths_map[u];
+                }
+            }
+        }
+    }
+
+    // Accumulates the dependencies of the reached vertices, then resets
+    // their labels
+    void accumulate(workspace & w, const std::uint32_t s) {
+        for(auto it = w.order.rbegin(); it != w.order.rend(); ++it) {
+            const std::uint32_t u = *it;
+            const value_t u_dist = w.dist_map[u];
+            double sum = 0.0;
+            for(std::size_t i = _out_begin[u]; i < _out_begin[u + 1]; ++i) {
+                const std::uint32_t v = _out_neighbors[i];
+                const value_t length =
+                    _unit_lengths ? value_t{1} : _out_lengths[i];
+                if(w.dist_map[v] == u_dist + length)
+                    sum += w.coefficient_map[v];
+            }
+            const double dependency = w.nb_paths_map[u] * sum;
+            if(u != s) w.centrality_map[u] += dependency;
+            w.coefficient_map[u] = (1.0 + dependency) / w.nb_paths_map[u];
+        }
+        for(const std::uint32_t u : w.order) {
+            w.dist_map[u] = infinity;
+            w.nb_paths_map[u] = 0.0;
+            w.coefficient_map[u] = 0.0;
+        }
+        w.order.clear();
+    }
+};
+
+#endif  // BETWEENNESS_CENTRALITY_HPP
@@ -0,0 +1,107 @@
+#ifndef BFS_WORKSPACE_HPP
+#define BFS_WORKSPACE_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "melon/container/static_digraph.hpp"
+
+enum class visited_storage : char { epoch, bitmap };
+
+/**
+ * @brief Breadth first search whose visited set and queue are reused from
+ * one query to the next.
+ *
+ * With visited_storage::epoch, the visited set is a map of generation
+ * stamps and a query increments the generation. With visited_storage::bitmap,
+ * it is a bitmap whose bits are cleared at the next query by walking the
+ * queue of the previous one. Either way, the cost of a query only depends on
+ * the vertices it reaches. The traits also tell whether the levels and the
+ * parents of the visited vertices are written into the buffers given to
+ * run(), whose entries of unvisited vertices are left untouched.
+ */
+template <typename Graph, typename Traits>
+class bfs_workspace {
+public:
+    using vertex = fhamonic::melon::vertex_t<Graph>;
+
+private:
+    using stamp_t = std::uint32_t;
+    static constexpr bool use_bitmap =
+        Traits::visited == visited_storage::bitmap;
+
+    std::reference_wrapper<const Graph> _graph;
+    std::vector<stamp_t> _stamp_map;
+    std::vector<std::uint64_t> _visited_bitmap;
+    stamp_t _stamp;
+    std::vector<vertex> _queue;
+
+public:
+    [[nodiscard]] bfs_workspace(Traits, const Graph & g)
+        : _graph(std::cref(g))
+        , _stamp_map(use_bitmap ? 0 : g.nb_vertices(), 0)
+        , _visited_bitmap(use_bitmap ? (g.nb_vertices() + 63) / 64 : 0, 0)
+        , _stamp(0) {
+        _queue.reserve(g.nb_vertices());
+    }
+
+    [[nodiscard]] bool visited(const vertex u) const noexcept {
+        if constexpr(use_bitmap)
+            return _visited_bitmap[u / 64] >> (u % 64) & 1;
+        else
+            return _stamp_map[u] == _stamp;
+    }
+    // visited vertices of the last query, in visiting order
+    [[nodiscard]] std::span<const vertex> order() const noexcept {
+        return _queue;
+    }
+
+    void run(const vertex s, std::span<std::uint32_t> level_map = {},
+             std::span<vertex> parent_map = {}) {
+        const Graph & g = _graph.get();
+        assert(!Traits::store_levels || level_map.size() >= g.nb_vertices());
+        assert(!Traits::store_parents || parent_map.size() >= g.nb_vertices());
+        new_query();
+        mark(s);
+        _queue.push_back(s);
+        if constexpr(Traits::store_levels) level_map[s] = 0;
+        if constexpr(Traits::store_parents) parent_map[s] = s;
+        for(std::size_t head = 0; head < _queue.size(); ++head) {
+            const vertex u = _queue[head];
+            for(auto && v : g.out_neighbors(u)) {
+                if(visited(v)) continue;
+                mark(v);
+                _queue.push_back(v);
+                if constexpr(Traits::store_levels)
+                    level_map[v] = level_map[u] + 1;
+                if constexpr(Traits::store_parents) parent_map[v] = u;
+            }
+        }
+    }
+
+private:
+    void mark(const vertex u) noexcept {
+        if constexpr(use_bitmap)
+            _visited_bitmap[u / 64] |= std::uint64_t{1} << (u % 64);
+        else
+            _stamp_map[u] = _stamp;
+    }
+    void new_query() noexcept {
+        if constexpr(use_bitmap) {
+            for(const vertex u : _queue) _visited_bitmap[u / 64] = 0;
+        } else if(++_stamp == 0) {
+            std::fill(_stamp_map.begin(), _stamp_map.end(), stamp_t{0});
+            _stamp = 1;
+        }
+        _queue.clear();
+    }
+};
+
+#endif  // BFS_WORKSPACE_HPP
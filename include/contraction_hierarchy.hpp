@@ -0,0 +1,300 @@
+#ifndef CONTRACTION_HIERARCHY_HPP
+#define CONTRACTION_HIERARCHY_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "melon/container/static_digraph.hpp"
+
+/**
+ * @brief Contraction hierarchy of a weighted digraph.
+ *
+ * Vertices are contracted one by one in the order of a lazily updated
+ * priority combining the edge difference, the number of already contracted
+ * neighbors and the depth of the vertex in the hierarchy built so far, which
+ * keeps the contraction spread uniformly over the graph. Contracting a
+ * vertex adds a shortcut between each pair of its remaining in and out
+ * neighbors unless a witness search, a local Dijkstra bounded by a number of
+ * settled vertices, finds a path that is not longer.
+ * The hierarchy keeps, for each vertex, its upward arcs (towards higher
+ * ranks) and its downward in-arcs (from higher ranks).
+ */
+template <typename Graph, typename LengthMap>
+class contraction_hierarchy {
+public:
+    using vertex = fhamonic::melon::vertex_t<Graph>;
+    using arc = fhamonic::melon::arc_t<Graph>;
+    using value_t = std::decay_t<decltype(std::declval<const LengthMap &>()[
+        std::declval<arc>()])>;
+    struct hierarchy_arc {
+        vertex other_end;
+        value_t length;
+    };
+
+private:
+    static constexpr std::size_t simulation_settle_limit = 32;
+    static constexpr std::size_t contraction_settle_limit = 256;
+
+    std::size_t _nb_vertices;
+    std::vector<std::uint32_t> _rank_map;
+    std::vector<std::size_t> _up_arcs_begin;
+    std::vector<hierarchy_arc> _up_arcs;
+    std::vector<std::size_t> _down_arcs_begin;
+    std::vector<hierarchy_arc> _down_arcs;
+    std::size_t _nb_shortcuts;
+
+    // contraction state, released at the end of the construction
+    std::vector<std::vector<hierarchy_arc>> _out_arcs;
+    std::vector<std::vector<hierarchy_arc>> _in_arcs;
+    std::vector<char> _contracted_map;
+    std::vector<std::uint32_t> _deleted_neighbors_map;
+    std::vector<std::uint32_t> _level_map;
+    std::vector<value_t> _witness_dist_map;
+    std::vector<std::uint32_t> _witness_stamp_map;
+    std::vector<std::uint32_t> _target_stamp_map;
+    std::uint32_t _witness_stamp;
+    std::vector<std::pair<value_t, vertex>> _witness_heap;
+    std::vector<std::pair<vertex, value_t>> _shortcuts;
+
+public:
+    [[nodiscard]] contraction_hierarchy(const Graph & g, const LengthMap & l)
+        : _nb_vertices(g.nb_vertices())
+        , _rank_map(g.nb_vertices())
+        , _nb_shortcuts(0)
+        , _out_arcs(g.nb_vertices())
+        , _in_arcs(g.nb_vertices())
+        , _contracted_map(g.nb_vertices(), false)
+        , _deleted_neighbors_map(g.nb_vertices(), 0)
+        , _level_map(g.nb_vertices(), 0)
+        , _witness_dist_map(g.nb_vertices())
+        , _witness_stamp_map(g.nb_vertices(), 0)
+        , _target_stamp_map(g.nb_vertices(), 0)
+        , _witness_stamp(0) {
+        for(auto && u : g.vertices())
+            for(auto && a : g.out_arcs(u))
+                add_arc(u, g.arc_target(a), l[a]);
+        contract_all();
+        release_contraction_state();
+    }
+
+    [[nodiscard]] std::size_t nb_vertices() const noexcept {
+        return _nb_vertices;
+    }
+    [[nodiscard]] std::size_t nb_shortcuts() const noexcept {
+        return _nb_shortcuts;
+    }
+    [[nodiscard]] std::uint32_t rank(const vertex u) const noexcept {
+        return _rank_map[u];
+    }
+    // arcs from u to vertices of higher rank
+    [[nodiscard]] std::span<const hierarchy_arc> up_arcs(
+        const vertex u) const noexcept {
+        return {_up_arcs.data() + _up_arcs_begin[u],
+                _up_arcs.data() + _up_arcs_begin[u + 1]};
+    }
+    // arcs to u from vertices of higher rank
+    [[nodiscard]] std::span<const hierarchy_arc> down_in_arcs(
+        const vertex u) const noexcept {
+        return {_down_arcs.data() + _down_arcs_begin[u],
+                _down_arcs.data() + _down_arcs_begin[u + 1]};
+    }
+
+private:
+    static void add_or_improve(std::vector<hierarchy_arc> & arcs,
+                               const vertex other_end, const value_t length) {
+        for(auto & a : arcs) {
+            if(a.other_end != other_end) continue;
+            a.length = std::min(a.length, length);
+            return;
+        }
+        arcs.push_back({other_end, length});
+    }
+    static void remove(std::vector<hierarchy_arc> & arcs,
+                       const vertex other_end) noexcept {
+        for(std::size_t i = 0; i < arcs.size(); ++i) {
+            if(arcs[i].other_end != other_end) continue;
+            arcs[i] = arcs.back();
+            arcs.pop_back();
+            return;
+        }
+    }
+    void add_arc(const vertex u, const vertex w, const value_t length) {
+        if(u == w) return;
+        add_or_improve(_out_arcs[u], w, length);
+        add_or_improve(_in_arcs[w], u, length);
+    }
+
+    // Dijkstra from u in the remaining graph without v, stopped when the
+    // minimum exceeds bound, when the nb_targets out neighbors of v are
+    // settled or after settle_limit settled vertices
+    void witness_search(const vertex u, const vertex v, const value_t bound,
+                        std::size_t nb_targets,
+                        const std::size_t settle_limit) {
+        _witness_heap.clear();
+        _witness_stamp_map[u] = _witness_stamp;
+        _witness_dist_map[u] = value_t{0};
+        _witness_heap.emplace_back(value_t{0}, u);
+        std::size_t nb_settled = 0;
+        while(!_witness_heap.empty()) {
+            std::pop_heap(_witness_heap.begin(), _witness_heap.end(),
+                          std::greater<>());
+            const auto [x_dist, x] = _witness_heap.back();
+            _witness_heap.pop_back();
+            if(x_dist > _witness_dist_map[x]) continue;
+            if(x_dist > bound || ++nb_settled > settle_limit) break;
+            if(_target_stamp_map[x] == _witness_stamp && --nb_targets == 0)
+                break;
+            for(auto && [w, length] : _out_arcs[x]) {
+                if(w == v) continue;
+                const value_t new_dist = x_dist + length;
+                if(_witness_stamp_map[w] != _witness_stamp ||
+                   new_dist < _witness_dist_map[w]) {
+                    _witness_stamp_map[w] = _witness_stamp;
+                    _witness_dist_map[w] = new_dist;
+                    _witness_heap.emplace_back(new_dist, w);
+                    std::push_heap(_witness_heap.begin(), _witness_heap.end(),
+                                   std::greater<>());
+                }
+            }
+        }
+    }
+    [[nodiscard]] bool has_witness(const vertex w,
+                                   const value_t length) const noexcept {
+        return _witness_stamp_map[w] == _witness_stamp &&
+               _witness_dist_map[w] <= length;
+    }
+
+    // Fills _shortcuts with the shortcuts needed to contract v
+    void compute_shortcuts(const vertex v, const std::size_t settle_limit) {
+        _shortcuts.clear();
+        for(auto && [u, in_length] : _in_arcs[v]) {
+            if(++_witness_stamp == 0) {
+                std::fill(_witness_stamp_map.begin(),
+                          _witness_stamp_map.end(), 0);
+                std::fill(_target_stamp_map.begin(), _target_stamp_map.end(),
+                          0);
+                _witness_stamp = 1;
+            }
+            // u is not a target and each distinct target is counted once,
+            // otherwise the search could stop before settling them all
+            value_t bound = value_t{0};
+            std::size_t nb_targets = 0;
+            for(auto && [w, out_length] : _out_arcs[v]) {
+                if(w == u) continue;
+                bound = std::max(bound, in_length + out_length);
+                if(_target_stamp_map[w] == _witness_stamp) continue;
+                _target_stamp_map[w] = _witness_stamp;
+                ++nb_targets;
+            }
+            if(nb_targets == 0) continue;
+            witness_search(u, v, bound, nb_targets, settle_limit);
+            for(auto && [w, out_length] : _out_arcs[v]) {
+                if(w == u || has_witness(w, in_length + out_length)) continue;
+                _shortcuts.emplace_back(u, in_length + out_length);
+                _shortcuts.emplace_back(w, in_length + out_length);
+            }
+        }
+    }
+    [[nodiscard]] long priority(const vertex v) {
+        compute_shortcuts(v, simulation_settle_limit);
+        const long edge_difference =
+            static_cast<long>(_shortcuts.size() / 2) -
+            static_cast<long>(_in_arcs[v].size() + _out_arcs[v].size());
+        return 4 * edge_difference +
+               static_cast<long>(_deleted_neighbors_map[v]) +
+               static_cast<long>(_level_map[v]);
+    }
+
+    void contract(const vertex v, std::vector<std::vector<hierarchy_arc>> & up,
+                  std::vector<std::vector<hierarchy_arc>> & down_in) {
+        compute_shortcuts(v, contraction_settle_limit);
+        for(std::size_t i = 0; i < _shortcuts.size(); i += 2) {
+            add_arc(_shortcuts[i].first, _shortcuts[i + 1].first,
+                    _shortcuts[i].second);
+            ++_nb_shortcuts;
+        }
+        up[v] = std::move(_out_arcs[v]);
+        down_in[v] = std::move(_in_arcs[v]);
+        for(auto && [w, length] : up[v]) {
+            remove(_in_arcs[w], v);
+            ++_deleted_neighbors_map[w];
+            _level_map[w] = std::max(_level_map[w], _level_map[v] + 1);
+        }
+        for(auto && [u, length] : down_in[v]) {
+            remove(_out_arcs[u], v);
+            ++_deleted_neighbors_map[u];
+            _level_map[u] = std::max(_level_map[u], _level_map[v] + 1);
+        }
+        _contracted_map[v] = true;
+    }
+
+    void contract_all() {
+        using entry = std::pair<long, vertex>;
+        std::priority_queue<entry, std::vector<entry>, std::greater<entry>>
+            queue;
+        std::vector<long> priority_map(_nb_vertices);
+        for(vertex v = 0; v < static_cast<vertex>(_nb_vertices); ++v) {
+            priority_map[v] = priority(v);
+            queue.emplace(priority_map[v], v);
+        }
+
+        std::vector<std::vector<hierarchy_arc>> up(_nb_vertices);
+        std::vector<std::vector<hierarchy_arc>> down_in(_nb_vertices);
+        std::vector<vertex> neighbors;
+        std::uint32_t next_rank = 0;
+        while(!queue.empty()) {
+            const auto [p, v] = queue.top();
+            queue.pop();
+            if(_contracted_map[v] || p != priority_map[v]) continue;
+            // lazy update: contract v only if it is still the minimum
+            priority_map[v] = priority(v);
+            if(!queue.empty() && priority_map[v] > queue.top().first) {
+                queue.emplace(priority_map[v], v);
+                continue;
+            }
+            neighbors.clear();
+            for(auto && [w, length] : _out_arcs[v]) neighbors.push_back(w);
+            for(auto && [u, length] : _in_arcs[v]) neighbors.push_back(u);
+            contract(v, up, down_in);
+            _rank_map[v] = next_rank++;
+            for(const vertex w : neighbors) {
+                const long new_priority = priority(w);
+                if(new_priority == priority_map[w]) continue;
+                priority_map[w] = new_priority;
+                queue.emplace(new_priority, w);
+            }
+        }
+
+        _up_arcs_begin.assign(1, 0);
+        _down_arcs_begin.assign(1, 0);
+        for(std::size_t v = 0; v < _nb_vertices; ++v) {
+            _up_arcs.insert(_up_arcs.end(), up[v].begin(), up[v].end());
+            _up_arcs_begin.push_back(_up_arcs.size());
+            _down_arcs.insert(_down_arcs.end(), down_in[v].begin(),
+                              down_in[v].end());
+            _down_arcs_begin.push_back(_down_arcs.size());
+        }
+    }
+
+    void release_contraction_state() {
+        _out_arcs = {};
+        _in_arcs = {};
+        _contracted_map = {};
+        _deleted_neighbors_map = {};
+        _level_map = {};
+        _witness_dist_map = {};
+        _witness_stamp_map = {};
+        _target_stamp_map = {};
+        _witness_heap = {};
+        _shortcuts = {};
+    }
+};
+
+#endif  // CONTRACTION_HIERARCHY_HPP
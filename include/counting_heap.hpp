@@ -0,0 +1,43 @@
+#ifndef COUNTING_HEAP_HPP
+#define COUNTING_HEAP_HPP
+
+#include <cstddef>
+
+struct heap_operation_counts {
+    std::size_t nb_push = 0;
+    std::size_t nb_promote = 0;
+    std::size_t nb_pop = 0;
+
+    void reset() { nb_push = nb_promote = nb_pop = 0; }
+};
+
+/**
+ * @brief Heap adaptor counting push, promote and pop operations.
+ *
+ * The heap is built by the algorithm that uses it, so the counts are kept
+ * in a static member that the benchmark reads after the runs.
+ */
+template <typename Heap>
+class counting_heap : public Heap {
+public:
+    static inline heap_operation_counts counts;
+
+    using Heap::Heap;
+
+    constexpr void push(const typename Heap::id_type & id,
+                        const typename Heap::priority_type & p) {
+        ++counts.nb_push;
+        Heap::push(id, p);
+    }
+    constexpr void promote(const typename Heap::id_type & id,
+                           const typename Heap::priority_type & p) {
+        ++counts.nb_promote;
+        Heap::promote(id, p);
+    }
+    constexpr void pop() {
+        ++counts.nb_pop;
+        Heap::pop();
+    }
+};
+
+#endif  // COUNTING_HEAP_HPP
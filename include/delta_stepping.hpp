@@ -0,0 +1,296 @@
+#ifndef DELTA_STEPPING_HPP
+#define DELTA_STEPPING_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "melon/container/static_digraph.hpp"
+
+/**
+ * @brief Parallel delta-stepping single source shortest paths.
+ *
+ * Arcs are copied in a CSR where the light arcs (length <= delta) of each
+ * vertex precede its heavy arcs. Each thread owns a cyclic array of
+ * buckets in which it inserts the vertices it improves, and the contents of
+ * the current bucket are shared among the threads at every light phase.
+ * The worker threads are created with the engine and park on a barrier
+ * between queries, so that a query only pays for its phases; they
+ * synchronize on barriers between phases.
+ */
+template <typename Graph, typename LengthMap>
+class delta_stepping {
+public:
+    using vertex = fhamonic::melon::vertex_t<Graph>;
+    using arc = fhamonic::melon::arc_t<Graph>;
+    using value_t = std::decay_t<decltype(std::declval<const LengthMap &>()[
+        std::declval<arc>()])>;
+
+private:
+    struct out_arc {
+        vertex target;
+        value_t length;
+    };
+    struct thread_data {
+        std::vector<std::vector<vertex>> buckets;
+        std::vector<vertex> frontier;
+        std::vector<vertex> removed;
+        std::size_t next_bucket;
+    };
+
+    // barrier completion steps, run by a single thread
+    struct reset_end_step {
+        delta_stepping * ds;
+        void operator()() noexcept { ds->on_search_start(); }
+    };
+    struct gather_step {
+        delta_stepping * ds;
+        void operator()() noexcept { ds->gather_frontier(); }
+    };
+    struct select_step {
+        delta_stepping * ds;
+        void operator()() noexcept { ds->select_next_bucket(); }
+    };
+
+    static constexpr value_t infinity = std::numeric_limits<value_t>::max();
+    static constexpr std::size_t no_bucket =
+        std::numeric_limits<std::size_t>::max();
+    static constexpr std::size_t chunk_size = 64;
+
+    std::size_t _nb_vertices;
+    value_t _delta;
+    std::size_t _nb_threads;
+    std::vector<std::size_t> _arcs_begin;
+    std::vector<std::size_t> _heavy_arcs_begin;
+    std::vector<out_arc> _arcs;
+    std::size_t _nb_buckets;
+
+    std::vector<std::atomic<value_t>> _dist_map;
+    std::vector<std::atomic<std::size_t>> _removed_bucket_map;
+    std::vector<thread_data> _threads_data;
+    std::vector<std::size_t> _frontier_offsets;
+    std::atomic<std::size_t> _next_chunk;
+    std::size_t _current_bucket;
+    bool _current_bucket_empty;
+    vertex _source;
+    bool _stop;
+
+    std::barrier<> _sync_start;
+    std::barrier<reset_end_step> _sync_reset;
+    std::barrier<gather_step> _gather_barrier;
+    std::barrier<select_step> _select_barrier;
+    std::barrier<> _phase_barrier;
+    std::vector<std::thread> _workers;
+
+public:
+    [[nodiscard]] delta_stepping(const Graph & g, const LengthMap & l,
+                                 const value_t delta,
+                                 const std::size_t nb_threads)
+        : _nb_vertices(g.nb_vertices())
+        , _delta(delta)
+        , _nb_threads(std::max(nb_threads, std::size_t{1}))
+        , _arcs_begin(g.nb_vertices() + 1)
+        , _heavy_arcs_begin(g.nb_vertices())
+        , _arcs()
+        , _dist_map(g.nb_vertices())
+        , _removed_bucket_map(g.nb_vertices())
+        , _threads_data(_nb_threads)
+        , _frontier_offsets(_nb_threads + 1)
+        , _next_chunk(0)
+        , _current_bucket(0)
+        , _current_bucket_empty(false)
+        , _source(0)
+        , _stop(false)
+        , _sync_start(static_cast<std::ptrdiff_t>(_nb_threads))
+        , _sync_reset(static_cast<std::ptrdiff_t>(_nb_threads),
+                      reset_end_step{this})
+        , _gather_barrier(static_cast<std::ptrdiff_t>(_nb_threads),
+                          gather_step{this})
+        , _select_barrier(static_cast<std::ptrdiff_t>(_nb_threads),
+                          select_step{this})
+        , _phase_barrier(static_cast<std::ptrdiff_t>(_nb_threads)) {
+        value_t max_length = 0;
+        _arcs.reserve(g.nb_arcs());
+        for(auto && u : g.vertices()) {
+            _arcs_begin[u] = _arcs.size();
+            for(auto && a : g.out_arcs(u))
+                if(l[a] <= _delta) _arcs.push_back({g.arc_target(a), l[a]});
+            _heavy_arcs_begin[u] = _arcs.size();
+            for(auto && a : g.out_arcs(u)) {
+                if(l[a] > _delta) _arcs.push_back({g.arc_target(a), l[a]});
+                max_length = std::max(max_length, l[a]);
+            }
+        }
+        _arcs_begin[_nb_vertices] = _arcs.size();
+        // tentative distances never exceed the current bucket by more than
+        // the maximal arc length
+        _nb_buckets =
+            static_cast<std::size_t>(std::floor(max_length / _delta)) + 2;
+        for(auto & data : _threads_data)
+            data.buckets.resize(_nb_buckets);
+        for(std::size_t t = 1; t < _nb_threads; ++t)
+            _workers.emplace_back([this, t]() {
+                for(;;) {
+                    _sync_start.arrive_and_wait();
+                    if(_stop) break;
+                    search(t);
+                }
+            });
+    }
+    delta_stepping(const delta_stepping &) = delete;
+    delta_stepping & operator=(const delta_stepping &) = delete;
+    ~delta_stepping() {
+        _stop = true;
+        _sync_start.arrive_and_wait();
+        for(auto & worker : _workers) worker.join();
+    }
+
+    [[nodiscard]] value_t delta() const noexcept { return _delta; }
+    [[nodiscard]] std::size_t nb_threads() const noexcept {
+        return _nb_threads;
+    }
+    [[nodiscard]] bool reached(const vertex u) const noexcept {
+        return _dist_map[u].load(std::memory_order_relaxed) != infinity;
+    }
+    [[nodiscard]] value_t dist(const vertex u) const noexcept {
+        return _dist_map[u].load(std::memory_order_relaxed);
+    }
+
+private:
+    [[nodiscard]] std::size_t bucket_of(const value_t d) const noexcept {
+        return static_cast<std::size_t>(std::floor(d / _delta));
+    }
+
+    void relax(thread_data & data, const vertex v, const value_t new_dist) {
+        value_t old_dist = _dist_map[v].load(std::memory_order_relaxed);
+        while(new_dist < old_dist) {
+            if(_dist_map[v].compare_exchange_weak(old_dist, new_dist,
+                                                  std::memory_order_relaxed)) {
+                data.buckets[bucket_of(new_dist) % _nb_buckets].push_back(v);
+                return;
+            }
+        }
+    }
+
+    // Relaxes the light arcs of the vertices of the current bucket that are
+    // in the shared frontier, by chunks of chunk_size vertices
+    void light_phase(thread_data & data) {
+        const std::size_t frontier_size = _frontier_offsets[_nb_threads];
+        for(;;) {
+            const std::size_t chunk_begin = _next_chunk.fetch_add(
+                chunk_size, std::memory_order_relaxed);
+            if(chunk_begin >= frontier_size) break;
+            const std::size_t chunk_end =
+                std::min(chunk_begin + chunk_size, frontier_size);
+            std::size_t t = static_cast<std::size_t>(
+                std::upper_bound(_frontier_offsets.begin(),
+                                 _frontier_offsets.end(), chunk_begin) -
+                _frontier_offsets.begin() - 1);
+            for(std::size_t i = chunk_begin; i < chunk_end; ++i) {
+                while(i >= _frontier_offsets[t + 1]) ++t;
+                const vertex u =
+                    _threads_data[t].frontier[i - _frontier_offsets[t]];
+                const value_t u_dist =
+                    _dist_map[u].load(std::memory_order_relaxed);
+                if(bucket_of(u_dist) != _current_bucket) continue;
+                if(_removed_bucket_map[u].exchange(
+                       _current_bucket, std::memory_order_relaxed) !=
+                   _current_bucket)
+                    data.removed.push_back(u);
+                for(std::size_t j = _arcs_begin[u]; j < _heavy_arcs_begin[u];
+                    ++j)
+                    relax(data, _arcs[j].target, u_dist + _arcs[j].length);
+            }
+        }
+    }
+
+    void heavy_phase(thread_data & data) {
+        for(const vertex u : data.removed) {
+            const value_t u_dist = _dist_map[u].load(std::memory_order_relaxed);
+            for(std::size_t j = _heavy_arcs_begin[u]; j < _arcs_begin[u + 1];
+                ++j)
+                relax(data, _arcs[j].target, u_dist + _arcs[j].length);
+        }
+        data.removed.clear();
+    }
+
+    void find_next_bucket(thread_data & data) {
+        data.next_bucket = no_bucket;
+        for(std::size_t i = 0; i < _nb_buckets; ++i) {
+            if(!data.buckets[(_current_bucket + i) % _nb_buckets].empty()) {
+                data.next_bucket = _current_bucket + i;
+                return;
+            }
+        }
+    }
+
+    void gather_frontier() noexcept {
+        _frontier_offsets[0] = 0;
+        for(std::size_t t = 0; t < _nb_threads; ++t)
+            _frontier_offsets[t + 1] =
+                _frontier_offsets[t] + _threads_data[t].frontier.size();
+        _current_bucket_empty = (_frontier_offsets[_nb_threads] == 0);
+        _next_chunk.store(0, std::memory_order_relaxed);
+    }
+
+    void select_next_bucket() noexcept {
+        _current_bucket = no_bucket;
+        for(auto & data : _threads_data)
+            _current_bucket = std::min(_current_bucket, data.next_bucket);
+    }
+
+public:
+    void run(const vertex s) {
+        _source = s;
+        _sync_start.arrive_and_wait();
+        search(0);
+    }
+
+private:
+    void search(const std::size_t t) {
+        thread_data & data = _threads_data[t];
+        // the maps are reset by slices and the buckets by their owners
+        // before the search
+        const std::size_t slice =
+            (_nb_vertices + _nb_threads - 1) / _nb_threads;
+        const std::size_t first = std::min(_nb_vertices, t * slice);
+        const std::size_t last = std::min(_nb_vertices, first + slice);
+        for(std::size_t u = first; u < last; ++u) {
+            _dist_map[u].store(infinity, std::memory_order_relaxed);
+            _removed_bucket_map[u].store(no_bucket, std::memory_order_relaxed);
+        }
+        for(auto & bucket : data.buckets) bucket.clear();
+        if(t == 0) data.buckets[0].push_back(_source);
+        _sync_reset.arrive_and_wait();
+        for(;;) {
+            for(;;) {
+                data.frontier.clear();
+                data.frontier.swap(data.buckets[_current_bucket % _nb_buckets]);
+                _gather_barrier.arrive_and_wait();
+                if(_current_bucket_empty) break;
+                light_phase(data);
+                _phase_barrier.arrive_and_wait();
+            }
+            heavy_phase(data);
+            find_next_bucket(data);
+            _select_barrier.arrive_and_wait();
+            if(_current_bucket == no_bucket) break;
+        }
+    }
+
+    // The search state is only initialized once every thread left the
+    // previous search.
+    void on_search_start() noexcept {
+        _dist_map[_source].store(value_t{0}, std::memory_order_relaxed);
+        _current_bucket = 0;
+    }
+};
+
+#endif  // DELTA_STEPPING_HPP
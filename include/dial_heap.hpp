@@ -0,0 +1,143 @@
+#ifndef DIAL_HEAP_HPP
+#define DIAL_HEAP_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Dial's bucket queue with decrease-key, usable as the heap of
+ * melon's dijkstra for unsigned integer lengths.
+ *
+ * Buckets form a circular array indexed by priority modulo its size, which
+ * is a power of two. The array doubles whenever a priority falls out of
+ * the window starting at the current minimum, so that the maximal arc
+ * length need not be known in advance. Pushed and promoted priorities must
+ * not be smaller than the last priority returned by top().
+ * The indices map stores, for each id in the heap, its bucket in the high
+ * half of the word and its position in that bucket in the low half.
+ */
+template <typename ID, typename PRIO,
+          typename IndicesMap = std::vector<std::size_t>>
+class dial_heap {
+    static_assert(std::is_unsigned_v<PRIO>,
+                  "dial_heap requires unsigned integer priorities");
+    static_assert(sizeof(std::size_t) >= 8,
+                  "dial_heap encodes bucket and position in a 64 bits index");
+
+public:
+    using id_type = ID;
+    using priority_type = PRIO;
+    using entry = std::pair<id_type, priority_type>;
+    using indices_map = IndicesMap;
+
+private:
+    static constexpr std::size_t initial_nb_buckets = 1024;
+    static constexpr std::size_t position_bits = 32;
+    static constexpr std::size_t position_mask =
+        (std::size_t{1} << position_bits) - 1;
+
+    mutable std::vector<std::vector<entry>> _buckets;
+    mutable IndicesMap _indices_map;
+    mutable PRIO _current;
+    std::size_t _size;
+
+public:
+    [[nodiscard]] constexpr explicit dial_heap(IndicesMap && indices)
+        : _buckets(initial_nb_buckets)
+        , _indices_map(std::move(indices))
+        , _current(0)
+        , _size(0) {}
+
+    constexpr dial_heap(const dial_heap &) = default;
+    constexpr dial_heap(dial_heap &&) = default;
+    constexpr dial_heap & operator=(const dial_heap &) = default;
+    constexpr dial_heap & operator=(dial_heap &&) = default;
+
+    [[nodiscard]] constexpr std::size_t size() const noexcept { return _size; }
+    [[nodiscard]] constexpr bool empty() const noexcept { return _size == 0; }
+    constexpr void clear() noexcept {
+        for(auto & bucket : _buckets) bucket.clear();
+        _current = 0;
+        _size = 0;
+    }
+
+private:
+    [[nodiscard]] constexpr std::size_t bucket_of(const PRIO p) const noexcept {
+        return static_cast<std::size_t>(p) & (_buckets.size() - 1);
+    }
+    [[nodiscard]] static constexpr std::size_t encode(
+        const std::size_t bucket, const std::size_t position) noexcept {
+        return (bucket << position_bits) | position;
+    }
+    [[nodiscard]] static constexpr std::size_t bucket_index(
+        const std::size_t index) noexcept {
+        return index >> position_bits;
+    }
+    [[nodiscard]] static constexpr std::size_t position_index(
+        const std::size_t index) noexcept {
+        return index & position_mask;
+    }
+
+    constexpr void insert(const entry & e) noexcept {
+        const std::size_t b = bucket_of(e.second);
+        _indices_map[e.first] = encode(b, _buckets[b].size());
+        _buckets[b].push_back(e);
+    }
+    constexpr void erase(const std::size_t b, const std::size_t pos) noexcept {
+        auto & bucket = _buckets[b];
+        if(pos + 1 != bucket.size()) {
+            bucket[pos] = bucket.back();
+            _indices_map[bucket[pos].first] = encode(b, pos);
+        }
+        bucket.pop_back();
+    }
+    // Doubles the circular array until p fits in the window of _current
+    constexpr void grow(const PRIO p) {
+        std::size_t nb_buckets = _buckets.size();
+        while(static_cast<std::size_t>(p - _current) >= nb_buckets)
+            nb_buckets *= 2;
+        std::vector<std::vector<entry>> old_buckets(nb_buckets);
+        old_buckets.swap(_buckets);
+        for(const auto & bucket : old_buckets)
+            for(const auto & e : bucket) insert(e);
+    }
+    // Moves _current to the minimal priority of the heap
+    constexpr void seek() const noexcept {
+        while(_buckets[bucket_of(_current)].empty()) ++_current;
+    }
+
+public:
+    constexpr void push(const id_type & id, const priority_type & p) {
+        assert(p >= _current);
+        if(static_cast<std::size_t>(p - _current) >= _buckets.size()) grow(p);
+        insert(entry(id, p));
+        ++_size;
+    }
+    [[nodiscard]] constexpr const priority_type & priority(
+        const id_type & id) const noexcept {
+        const std::size_t index = _indices_map[id];
+        return _buckets[bucket_index(index)][position_index(index)].second;
+    }
+    constexpr void promote(const id_type & id, const priority_type & p) {
+        assert(p >= _current);
+        const std::size_t index = _indices_map[id];
+        erase(bucket_index(index), position_index(index));
+        insert(entry(id, p));
+    }
+    [[nodiscard]] constexpr entry top() const noexcept {
+        assert(!empty());
+        seek();
+        return _buckets[bucket_of(_current)].back();
+    }
+    constexpr void pop() noexcept {
+        assert(!empty());
+        seek();
+        _buckets[bucket_of(_current)].pop_back();
+        --_size;
+    }
+};
+
+#endif  // DIAL_HEAP_HPP
@@ -0,0 +1,145 @@
+#ifndef DIJKSTRA_WORKSPACE_HPP
+#define DIJKSTRA_WORKSPACE_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "melon/algorithm/dijkstra.hpp"
+#include "melon/container/static_digraph.hpp"
+
+/**
+ * @brief Dijkstra whose buffers are reused from one query to the next.
+ *
+ * The workspace owns the heap, its indices map and the distance and
+ * predecessor maps. Instead of reinitializing them, reset() increments a
+ * generation counter: a vertex whose stamp is older than the current
+ * generation is considered unreached, so that the cost of a query only
+ * depends on the number of vertices it reaches. The traits follow the
+ * dijkstra traits of melon (semiring, heap, store_paths).
+ */
+template <typename Graph, typename LengthMap, typename Traits>
+class dijkstra_workspace {
+public:
+    using vertex = fhamonic::melon::vertex_t<Graph>;
+    using arc = fhamonic::melon::arc_t<Graph>;
+    using value_t = std::decay_t<decltype(std::declval<const LengthMap &>()[
+        std::declval<arc>()])>;
+    using traversal_entry = std::pair<vertex, value_t>;
+
+private:
+    using heap = typename Traits::heap;
+    using semiring = typename Traits::semiring;
+    struct no_pred_map {};
+    using pred_arcs_map = std::conditional_t<Traits::store_paths,
+                                             std::vector<arc>, no_pred_map>;
+
+    // stamps of the current generation are 2*generation for vertices in the
+    // heap and 2*generation+1 for settled vertices
+    using stamp_t = std::uint32_t;
+
+    std::reference_wrapper<const Graph> _graph;
+    std::reference_wrapper<const LengthMap> _length_map;
+    heap _heap;
+    std::vector<stamp_t> _stamp_map;
+    std::vector<value_t> _dist_map;
+    [[no_unique_address]] pred_arcs_map _pred_arcs_map;
+    stamp_t _in_heap_stamp;
+    std::size_t _nb_settled;
+
+public:
+    [[nodiscard]] dijkstra_workspace(Traits, const Graph & g,
+                                     const LengthMap & l)
+        : _graph(std::ref(g))
+        , _length_map(std::ref(l))
+        , _heap(fhamonic::melon::create_vertex_map<std::size_t>(g))
+        , _stamp_map(g.nb_vertices(), 0)
+        , _dist_map(g.nb_vertices())
+        , _pred_arcs_map()
+        , _in_heap_stamp(2)
+        , _nb_settled(0) {
+        if constexpr(Traits::store_paths)
+            _pred_arcs_map.resize(g.nb_vertices());
+    }
+
+    // O(size of the heap), which is empty after a complete run
+    void reset() noexcept {
+        _heap.clear();
+        _nb_settled = 0;
+        if(_in_heap_stamp >= std::numeric_limits<stamp_t>::max() - 2) {
+            std::fill(_stamp_map.begin(), _stamp_map.end(), stamp_t{0});
+            _in_heap_stamp = 0;
+        }
+        _in_heap_stamp += 2;
+    }
+
+    [[nodiscard]] bool reached(const vertex u) const noexcept {
+        return _stamp_map[u] >= _in_heap_stamp;
+    }
+    [[nodiscard]] bool settled(const vertex u) const noexcept {
+        return _stamp_map[u] == _in_heap_stamp + 1;
+    }
+    [[nodiscard]] value_t dist(const vertex u) const noexcept {
+        assert(settled(u));
+        return _dist_map[u];
+    }
+    [[nodiscard]] arc pred_arc(const vertex u) const noexcept
+        requires(Traits::store_paths)
+    {
+        assert(reached(u));
+        return _pred_arcs_map[u];
+    }
+    [[nodiscard]] std::size_t nb_settled() const noexcept {
+        return _nb_settled;
+    }
+
+    void add_source(const vertex s, const value_t dist = semiring::zero) {
+        assert(!reached(s));
+        _heap.push(s, dist);
+        _stamp_map[s] = _in_heap_stamp;
+    }
+    [[nodiscard]] bool finished() const noexcept { return _heap.empty(); }
+    [[nodiscard]] traversal_entry current() const noexcept {
+        assert(!finished());
+        return _heap.top();
+    }
+    // Settles the current vertex, relaxing only the arcs a such that
+    // is_allowed(a)
+    template <typename ArcFilter>
+    void advance(ArcFilter && is_allowed) {
+        const Graph & g = _graph.get();
+        const LengthMap & l = _length_map.get();
+        const auto [u, u_dist] = _heap.top();
+        _heap.pop();
+        _stamp_map[u] = _in_heap_stamp + 1;
+        _dist_map[u] = u_dist;
+        ++_nb_settled;
+        for(auto && a : g.out_arcs(u)) {
+            if(!is_allowed(a)) continue;
+            const vertex w = g.arc_target(a);
+            const stamp_t w_stamp = _stamp_map[w];
+            if(w_stamp == _in_heap_stamp) {
+                const value_t new_dist = semiring::plus(u_dist, l[a]);
+                if(semiring::less(new_dist, _heap.priority(w))) {
+                    _heap.promote(w, new_dist);
+                    if constexpr(Traits::store_paths) _pred_arcs_map[w] = a;
+                }
+            } else if(w_stamp < _in_heap_stamp) {
+                _heap.push(w, semiring::plus(u_dist, l[a]));
+                _stamp_map[w] = _in_heap_stamp;
+                if constexpr(Traits::store_paths) _pred_arcs_map[w] = a;
+            }
+        }
+    }
+    void advance() { advance([](const arc &) { return true; }); }
+    void run() {
+        while(!finished()) advance();
+    }
+};
+
+#endif  // DIJKSTRA_WORKSPACE_HPP
@@ -0,0 +1,201 @@
+#ifndef DIRECTION_OPTIMIZING_BFS_HPP
+#define DIRECTION_OPTIMIZING_BFS_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "melon/container/static_digraph.hpp"
+
+/**
+ * @brief Direction optimizing breadth first search (Beamer et al.).
+ *
+ * The out and in adjacencies are materialized as CSRs at construction.
+ * Each level is computed either top-down, by scanning the out arcs of the
+ * frontier held in a queue, or bottom-up, by scanning the in arcs of every
+ * unvisited vertex until one of them comes from the frontier, held in a
+ * bitmap. The search switches to bottom-up when the out arcs of the
+ * frontier exceed 1/alpha of the in arcs of the unvisited vertices, and
+ * back to top-down when the frontier shrinks below 1/beta of the vertices.
+ */
+template <typename Graph>
+class direction_optimizing_bfs {
+public:
+    using vertex = fhamonic::melon::vertex_t<Graph>;
+    static constexpr std::uint32_t unreached =
+        std::numeric_limits<std::uint32_t>::max();
+
+private:
+    std::size_t _nb_vertices;
+    std::size_t _nb_arcs;
+    std::vector<std::size_t> _out_begin;
+    std::vector<std::uint32_t> _out_neighbors;
+    std::vector<std::size_t> _in_begin;
+    std::vector<std::uint32_t> _in_neighbors;
+    double _alpha;
+    double _beta;
+
+    std::vector<std::uint32_t> _level_map;
+    std::vector<std::uint32_t> _queue;
+    std::vector<std::uint32_t> _next_queue;
+    std::vector<std::uint64_t> _frontier;
+    std::vector<std::uint64_t> _next_frontier;
+    std::size_t _nb_examined_arcs;
+    std::size_t _nb_bottom_up_steps;
+
+public:
+    [[nodiscard]] explicit direction_optimizing_bfs(const Graph & g,
+                                                    const double alpha = 14.0,
+                                                    const double beta = 24.0)
+        : _nb_vertices(g.nb_vertices())
+        , _nb_arcs(g.nb_arcs())
+        , _out_begin(g.nb_vertices() + 1, 0)
+        , _out_neighbors(g.nb_arcs())
+        , _in_begin(g.nb_vertices() + 1, 0)
+        , _in_neighbors(g.nb_arcs())
+        , _alpha(alpha)
+        , _beta(beta)
+        , _level_map(g.nb_vertices(), unreached)
+        , _frontier((g.nb_vertices() + 63) / 64)
+        , _next_frontier((g.nb_vertices() + 63) / 64)
+        , _nb_examined_arcs(0)
+        , _nb_bottom_up_steps(0) {
+        for(auto && u : g.vertices()) {
+            _out_begin[u + 1] = _out_begin[u];
+            for(auto && a : g.out_arcs(u)) {
+                _out_neighbors[_out_begin[u + 1]++] =
+                    static_cast<std::uint32_t>(g.arc_target(a));
+                ++_in_begin[g.arc_target(a) + 1];
+            }
+        }
+        for(std::size_t v = 0; v < _nb_vertices; ++v)
+            _in_begin[v + 1] += _in_begin[v];
+        std::vector<std::size_t> in_position(_in_begin.begin(),
+                                             _in_begin.end() - 1);
+        for(std::size_t u = 0; u < _nb_vertices; ++u)
+            for(std::size_t i = _out_begin[u]; i < _out_begin[u + 1]; ++i)
+                _in_neighbors[in_position[_out_neighbors[i]]++] =
+                    static_cast<std::uint32_t>(u);
+    }
+
+    [[nodiscard]] bool reached(const vertex u) const noexcept {
+        return _level_map[u] != unreached;
+    }
+    [[nodiscard]] std::uint32_t level(const vertex u) const noexcept {
+        assert(reached(u));
+        return _level_map[u];
+    }
+    [[nodiscard]] std::size_t nb_examined_arcs() const noexcept {
+        return _nb_examined_arcs;
+    }
+    [[nodiscard]] std::size_t nb_bottom_up_steps() const noexcept {
+        return _nb_bottom_up_steps;
+    }
+
+    void run(const vertex s) {
+        std::fill(_level_map.begin(), _level_map.end(), unreached);
+        _nb_examined_arcs = 0;
+        _nb_bottom_up_steps = 0;
+
+        _level_map[s] = 0;
+        _queue.assign(1, static_cast<std::uint32_t>(s));
+        std::size_t frontier_size = 1;
+        std::size_t frontier_arcs = out_degree(s);
+        std::size_t unvisited_arcs = _nb_arcs - in_degree(s);
+        bool bottom_up = false;
+        for(std::uint32_t level = 0; frontier_size > 0; ++level) {
+            const std::size_t previous_size = frontier_size;
+            if(!bottom_up && static_cast<double>(frontier_arcs) >
+                                 static_cast<double>(unvisited_arcs) / _alpha) {
+                queue_to_bitmap();
+                bottom_up = true;
+            }
+            frontier_arcs = 0;
+            if(bottom_up) {
+                ++_nb_bottom_up_steps;
+                frontier_size =
+                    bottom_up_step(level, frontier_arcs, unvisited_arcs);
+                std::swap(_frontier, _next_frontier);
+                if(frontier_size < previous_size &&
+                   static_cast<double>(frontier_size) <
+                       static_cast<double>(_nb_vertices) / _beta) {
+                    bitmap_to_queue();
+                    bottom_up = false;
+                }
+            } else {
+                frontier_size =
+                    top_down_step(level, frontier_arcs, unvisited_arcs);
+                std::swap(_queue, _next_queue);
+            }
+        }
+    }
+
+private:
+    [[nodiscard]] std::size_t out_degree(const std::size_t u) const noexcept {
+        return _out_begin[u + 1] - _out_begin[u];
+    }
+    [[nodiscard]] std::size_t in_degree(const std::size_t u) const noexcept {
+        return _in_begin[u + 1] - _in_begin[u];
+    }
+
+    void queue_to_bitmap() {
+        std::fill(_frontier.begin(), _frontier.end(), 0);
+        for(const std::uint32_t u : _queue)
+            _frontier[u / 64] |= std::uint64_t{1} << (u % 64);
+    }
+    void bitmap_to_queue() {
+        _queue.clear();
+        for(std::size_t w = 0; w < _frontier.size(); ++w) {
+            for(std::uint64_t bits = _frontier[w]; bits != 0;
+                bits &= bits - 1)
+                _queue.push_back(static_cast<std::uint32_t>(
+                    w * 64 + static_cast<std::size_t>(std::countr_zero(bits))));
+        }
+    }
+
+    std::size_t top_down_step(const std::uint32_t level,
+                              std::size_t & frontier_arcs,
+                              std::size_t & unvisited_arcs) {
+        _next_queue.clear();
+        for(const std::uint32_t u : _queue) {
+            _nb_examined_arcs += out_degree(u);
+            for(std::size_t i = _out_begin[u]; i < _out_begin[u + 1]; ++i) {
+                const std::uint32_t v = _out_neighbors[i];
+                if(_level_map[v] != unreached) continue;
+                _level_map[v] = level + 1;
+                _next_queue.push_back(v);
+                frontier_arcs += out_degree(v);
+                unvisited_arcs -= in_degree(v);
+            }
+        }
+        return _next_queue.size();
+    }
+
+    std::size_t bottom_up_step(const std::uint32_t level,
+                               std::size_t & frontier_arcs,
+                               std::size_t & unvisited_arcs) {
+        std::fill(_next_frontier.begin(), _next_frontier.end(), 0);
+        std::size_t next_size = 0;
+        for(std::size_t v = 0; v < _nb_vertices; ++v) {
+            if(_level_map[v] != unreached) continue;
+            for(std::size_t i = _in_begin[v]; i < _in_begin[v + 1]; ++i) {
+                ++_nb_examined_arcs;
+                const std::uint32_t u = _in_neighbors[i];
+                if(!(_frontier[u / 64] >> (u % 64) & 1)) continue;
+                _level_map[v] = level + 1;
+                _next_frontier[v / 64] |= std::uint64_t{1} << (v % 64);
+                ++next_size;
+                frontier_arcs += out_degree(v);
+                unvisited_arcs -= in_degree(v);
+                break;
+            }
+        }
+        return next_size;
+    }
+};
+
+#endif  // DIRECTION_OPTIMIZING_BFS_HPP
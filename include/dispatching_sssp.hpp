@@ -0,0 +1,245 @@
+#ifndef DISPATCHING_SSSP_HPP
+#define DISPATCHING_SSSP_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "melon/algorithm/dijkstra.hpp"
+#include "melon/container/static_digraph.hpp"
+
+enum class length_class : char {
+    unknown,        // classified at construction by a scan of the arcs
+    uniform,        // every arc has the same positive length
+    zero_or_unit,   // lengths are 0 or a single positive length
+    small_integer,  // nonnegative integers up to max_small_length
+    general
+};
+
+/**
+ * Smallest class of the lengths: uniform, zero_or_unit, small_integer or
+ * general, along with the positive length of the first two classes and the
+ * maximal length of the third. Non integral lengths are always general.
+ */
+template <typename Graph, typename LengthMap>
+auto classify_lengths(const Graph & g, const LengthMap & l,
+                      const std::size_t max_small_length = 1 << 16) {
+    using arc = fhamonic::melon::arc_t<Graph>;
+    using value_t = std::decay_t<decltype(std::declval<const LengthMap &>()[
+        std::declval<arc>()])>;
+    std::pair<length_class, value_t> result{length_class::general, 0};
+    if constexpr(std::is_integral_v<value_t>) {
+        value_t unit = 0, max_length = 0;
+        bool has_zero = false, has_other = false;
+        for(auto && a : g.arcs()) {
+            const value_t length = l[a];
+            if(length < 0) return result;
+            max_length = std::max(max_length, length);
+            if(length == 0) {
+                has_zero = true;
+            } else if(unit == 0) {
+                unit = length;
+            } else if(length != unit) {
+                has_other = true;
+            }
+        }
+        if(!has_other && unit > 0)
+            result = {has_zero ? length_class::zero_or_unit
+                               : length_class::uniform,
+                      unit};
+        else if(static_cast<std::size_t>(max_length) <= max_small_length)
+            result = {length_class::small_integer, max_length};
+    }
+    return result;
+}
+
+/**
+ * @brief Single source shortest paths that dispatch to the cheapest
+ * algorithm for the class of the lengths: a breadth first search for
+ * uniform lengths, a 0-1 BFS for lengths 0 or c, Dial's buckets for small
+ * integers and melon's dijkstra otherwise.
+ *
+ * The class can be fixed at compile time by the Class parameter, which
+ * compiles out the other algorithms, or detected at construction when it is
+ * length_class::unknown. Distances are reset lazily by generation stamps.
+ */
+template <typename Graph, typename LengthMap,
+          length_class Class = length_class::unknown>
+class dispatching_sssp {
+public:
+    using vertex = fhamonic::melon::vertex_t<Graph>;
+    using arc = fhamonic::melon::arc_t<Graph>;
+    using value_t = std::decay_t<decltype(std::declval<const LengthMap &>()[
+        std::declval<arc>()])>;
+
+private:
+    std::reference_wrapper<const Graph> _graph;
+    std::reference_wrapper<const LengthMap> _length_map;
+    length_class _class;
+    value_t _class_length;  // unit length or maximal small length
+    std::vector<value_t> _dist_map;
+    std::vector<std::uint32_t> _stamp_map;
+    std::uint32_t _stamp;
+    std::vector<vertex> _queue;
+    std::vector<vertex> _next_queue;
+    std::vector<std::vector<std::pair<vertex, value_t>>> _buckets;
+
+public:
+    [[nodiscard]] dispatching_sssp(const Graph & g, const LengthMap & l)
+        : _graph(std::cref(g))
+        , _length_map(std::cref(l))
+        , _class(Class)
+        , _class_length(0)
+        , _dist_map(g.nb_vertices())
+        , _stamp_map(g.nb_vertices(), 0)
+        , _stamp(0) {
+        if constexpr(Class == length_class::unknown) {
+            std::tie(_class, _class_length) = classify_lengths(g, l);
+        } else if constexpr(Class != length_class::general) {
+            static_assert(std::is_integral_v<value_t>);
+            for(auto && a : g.arcs())
+                _class_length = std::max(_class_length, l[a]);
+        }
+        if(_class == length_class::small_integer)
+            _buckets.resize(static_cast<std::size_t>(_class_length) + 1);
+    }
+    // the length map is kept by reference
+    dispatching_sssp(const Graph &, LengthMap &&) = delete;
+
+    [[nodiscard]] length_class algorithm() const noexcept { return _class; }
+    [[nodiscard]] bool reached(const vertex u) const noexcept {
+        return _stamp_map[u] == _stamp;
+    }
+    [[nodiscard]] value_t dist(const vertex u) const noexcept {
+        assert(reached(u));
+        return _dist_map[u];
+    }
+
+    void run(const vertex s) {
+        if(++_stamp == 0) {
+            std::fill(_stamp_map.begin(), _stamp_map.end(), 0);
+            _stamp = 1;
+        }
+        _stamp_map[s] = _stamp;
+        _dist_map[s] = value_t{0};
+        if constexpr(std::is_integral_v<value_t>) {
+            switch(_class) {
+                case length_class::uniform:
+                    if constexpr(allows(length_class::uniform)) bfs(s);
+                    return;
+                case length_class::zero_or_unit:
+                    if constexpr(allows(length_class::zero_or_unit))
+                        zero_or_unit_bfs(s);
+                    return;
+                case length_class::small_integer:
+                    if constexpr(allows(length_class::small_integer)) dial(s);
+                    return;
+                default:
+                    break;
+            }
+        }
+        if constexpr(allows(length_class::general)) run_dijkstra(s);
+    }
+
+private:
+    [[nodiscard]] static constexpr bool allows(const length_class c) noexcept {
+        return Class == length_class::unknown || Class == c;
+    }
+    // sets the label of v if v was not reached or new_dist is shorter
+    [[nodiscard]] bool improve(const vertex v,
+                               const value_t new_dist) noexcept {
+        if(_stamp_map[v] == _stamp && _dist_map[v] <= new_dist) return false;
+        _stamp_map[v] = _stamp;
+        _dist_map[v] = new_dist;
+        return true;
+    }
+
+    void bfs(const vertex s) {
+        const Graph & g = _graph.get();
+        _queue.clear();
+        _queue.push_back(s);
+        for(std::size_t head = 0; head < _queue.size(); ++head) {
+            const vertex u = _queue[head];
+            const value_t new_dist = _dist_map[u] + _class_length;
+            for(auto && v : g.out_neighbors(u)) {
+                if(_stamp_map[v] == _stamp) continue;
+                _stamp_map[v] = _stamp;
+                _dist_map[v] = new_dist;
+                _queue.push_back(v);
+            }
+        }
+    }
+
+    // Each level is a FIFO queue extended by the 0 arcs, the c arcs feeding
+    // the next level. Stale entries are skipped by comparing distances.
+    void zero_or_unit_bfs(const vertex s) {
+        const Graph & g = _graph.get();
+        const LengthMap & l = _length_map.get();
+        _queue.clear();
+        _queue.push_back(s);
+        value_t level = 0;
+        while(!_queue.empty()) {
+            _next_queue.clear();
+            for(std::size_t head = 0; head < _queue.size(); ++head) {
+                const vertex u = _queue[head];
+                if(_dist_map[u] != level) continue;
+                for(auto && a : g.out_arcs(u)) {
+                    const vertex v = g.arc_target(a);
+                    if(l[a] == 0) {
+                        if(improve(v, level)) _queue.push_back(v);
+                    } else if(improve(v, level + _class_length)) {
+                        _next_queue.push_back(v);
+                    }
+                }
+            }
+            std::swap(_queue, _next_queue);
+            level += _class_length;
+        }
+    }
+
+    // Circular array of max_length + 1 buckets holding every label within
+    // the window [d, d + max_length] of the current distance d
+    void dial(const vertex s) {
+        const Graph & g = _graph.get();
+        const LengthMap & l = _length_map.get();
+        const std::size_t nb_buckets = _buckets.size();
+        _buckets[0].emplace_back(s, value_t{0});
+        std::size_t nb_entries = 1;
+        std::size_t bucket = 0;
+        while(nb_entries > 0) {
+            auto & current = _buckets[bucket];
+            // vertices settled at the same distance may append to current
+            for(std::size_t i = 0; i < current.size(); ++i) {
+                const auto [u, u_dist] = current[i];
+                if(_dist_map[u] != u_dist) continue;
+                for(auto && a : g.out_arcs(u)) {
+                    const value_t new_dist = u_dist + l[a];
+                    const vertex v = g.arc_target(a);
+                    if(!improve(v, new_dist)) continue;
+                    _buckets[(bucket + static_cast<std::size_t>(l[a])) %
+                             nb_buckets]
+                        .emplace_back(v, new_dist);
+                    ++nb_entries;
+                }
+            }
+            nb_entries -= current.size();
+            current.clear();
+            bucket = (bucket + 1 == nb_buckets) ? 0 : bucket + 1;
+        }
+    }
+
+    void run_dijkstra(const vertex s) {
+        for(auto && [u, u_dist] :
+            fhamonic::melon::dijkstra(_graph.get(), _length_map.get(), s)) {
+            _stamp_map[u] = _stamp;
+            _dist_map[u] = u_dist;
+        }
+    }
+};
+
+#endif  // DISPATCHING_SSSP_HPP
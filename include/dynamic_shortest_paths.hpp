@@ -0,0 +1,185 @@
+#ifndef DYNAMIC_SHORTEST_PATHS_HPP
+#define DYNAMIC_SHORTEST_PATHS_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "melon/algorithm/dijkstra.hpp"
+
+/**
+ * @brief Single source shortest paths maintained under batches of arc length
+ * changes, in the way of Ramalingam and Reps.
+ *
+ * The distances and the shortest path tree are repaired after each batch
+ * instead of being recomputed. The vertices below a tree arc whose length
+ * increased lose their distance and are seeded with their best in-arc from
+ * the rest of the tree, the targets of decreased arcs are seeded with their
+ * improved distance, and a Dijkstra propagation from the seeds only scans
+ * the vertices whose distance changes. The graph must provide in_arcs.
+ */
+template <typename Graph, typename LengthMap>
+class dynamic_shortest_paths {
+public:
+    using vertex = fhamonic::melon::vertex_t<Graph>;
+    using arc = fhamonic::melon::arc_t<Graph>;
+    using value_t = std::decay_t<decltype(std::declval<const LengthMap &>()[
+        std::declval<arc>()])>;
+    using length_change = std::pair<arc, value_t>;
+
+private:
+    using heap = fhamonic::melon::d_ary_heap<
+        4, vertex, value_t,
+        decltype([](const auto & e1, const auto & e2) {
+            return e1.second < e2.second;
+        }),
+        fhamonic::melon::vertex_map_t<Graph, std::size_t>>;
+
+    static constexpr value_t infinity = std::numeric_limits<value_t>::max();
+
+    std::reference_wrapper<const Graph> _graph;
+    std::reference_wrapper<LengthMap> _length_map;
+    vertex _source;
+    std::vector<value_t> _dist_map;
+    std::vector<arc> _pred_arcs_map;
+    std::vector<char> _in_heap_map;
+    std::vector<char> _affected_map;
+    std::vector<vertex> _affected_vertices;
+    std::vector<vertex> _decreased_targets;
+    heap _heap;
+    std::size_t _nb_scanned;
+
+public:
+    [[nodiscard]] dynamic_shortest_paths(const Graph & g, LengthMap & l,
+                                         const vertex s)
+        : _graph(std::cref(g))
+        , _length_map(std::ref(l))
+        , _source(s)
+        , _dist_map(g.nb_vertices(), infinity)
+        , _pred_arcs_map(g.nb_vertices())
+        , _in_heap_map(g.nb_vertices(), false)
+        , _affected_map(g.nb_vertices(), false)
+        , _heap(fhamonic::melon::create_vertex_map<std::size_t>(g))
+        , _nb_scanned(0) {
+        _dist_map[s] = value_t{0};
+        _heap.push(s, value_t{0});
+        _in_heap_map[s] = true;
+        propagate();
+    }
+
+    [[nodiscard]] vertex source() const noexcept { return _source; }
+    [[nodiscard]] bool reached(const vertex u) const noexcept {
+        return _dist_map[u] != infinity;
+    }
+    [[nodiscard]] value_t dist(const vertex u) const noexcept {
+        assert(reached(u));
+        return _dist_map[u];
+    }
+    [[nodiscard]] arc pred_arc(const vertex u) const noexcept {
+        assert(reached(u) && u != _source);
+        return _pred_arcs_map[u];
+    }
+    // number of vertices scanned by the last update
+    [[nodiscard]] std::size_t nb_scanned() const noexcept {
+        return _nb_scanned;
+    }
+
+private:
+    [[nodiscard]] bool is_tree_arc(const arc a, const vertex v) const noexcept {
+        return v != _source && reached(v) && _pred_arcs_map[v] == a;
+    }
+
+    void improve(const vertex v, const value_t new_dist, const arc a) {
+        _dist_map[v] = new_dist;
+        _pred_arcs_map[v] = a;
+        if(_in_heap_map[v]) {
+            _heap.promote(v, new_dist);
+            return;
+        }
+        _heap.push(v, new_dist);
+        _in_heap_map[v] = true;
+    }
+
+    void propagate() {
+        const Graph & g = _graph.get();
+        const LengthMap & l = _length_map.get();
+        _nb_scanned = 0;
+        while(!_heap.empty()) {
+            const auto [u, u_dist] = _heap.top();
+            _heap.pop();
+            _in_heap_map[u] = false;
+            ++_nb_scanned;
+            for(auto && a : g.out_arcs(u)) {
+                const vertex w = g.arc_target(a);
+                const value_t new_dist = u_dist + l[a];
+                if(new_dist < _dist_map[w]) improve(w, new_dist, a);
+            }
+        }
+    }
+
+    // Marks the subtrees hanging from the tree arcs whose length increased
+    void collect_affected(const vertex root) {
+        const Graph & g = _graph.get();
+        const std::size_t first = _affected_vertices.size();
+        _affected_map[root] = true;
+        _affected_vertices.push_back(root);
+        for(std::size_t i = first; i < _affected_vertices.size(); ++i) {
+            const vertex x = _affected_vertices[i];
+            for(auto && a : g.out_arcs(x)) {
+                const vertex w = g.arc_target(a);
+                if(_affected_map[w] || !is_tree_arc(a, w)) continue;
+                _affected_map[w] = true;
+                _affected_vertices.push_back(w);
+            }
+        }
+    }
+
+public:
+    // Sets the lengths of the given arcs and repairs the distances
+    void update(const std::vector<length_change> & changes) {
+        const Graph & g = _graph.get();
+        LengthMap & l = _length_map.get();
+
+        _affected_vertices.clear();
+        _decreased_targets.clear();
+        for(auto && [a, new_length] : changes) {
+            const value_t old_length = l[a];
+            l[a] = new_length;
+            const vertex v = g.arc_target(a);
+            if(new_length > old_length) {
+                if(!_affected_map[v] && is_tree_arc(a, v)) collect_affected(v);
+            } else if(new_length < old_length) {
+                _decreased_targets.push_back(v);
+            }
+        }
+
+        for(const vertex v : _affected_vertices) _dist_map[v] = infinity;
+        for(const vertex v : _affected_vertices) {
+            for(auto && a : g.in_arcs(v)) {
+                const vertex x = g.arc_source(a);
+                if(_affected_map[x] || !reached(x)) continue;
+                const value_t new_dist = _dist_map[x] + l[a];
+                if(new_dist < _dist_map[v]) improve(v, new_dist, a);
+            }
+        }
+        for(const vertex v : _affected_vertices) _affected_map[v] = false;
+
+        // the decreased arcs are read again in case of duplicate changes
+        for(const vertex v : _decreased_targets) {
+            for(auto && a : g.in_arcs(v)) {
+                const vertex x = g.arc_source(a);
+                if(!reached(x)) continue;
+                const value_t new_dist = _dist_map[x] + l[a];
+                if(new_dist < _dist_map[v]) improve(v, new_dist, a);
+            }
+        }
+
+        propagate();
+    }
+};
+
+#endif  // DYNAMIC_SHORTEST_PATHS_HPP
@@ -0,0 +1,142 @@
+#ifndef FLOYD_WARSHALL_HPP
+#define FLOYD_WARSHALL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "melon/container/static_digraph.hpp"
+
+/**
+ * @brief All pairs shortest paths by a cache blocked Floyd-Warshall on a
+ * dense distance matrix.
+ *
+ * The matrix is padded to a multiple of BlockSize and, for each block k of
+ * pivots, the diagonal block is updated first, then the blocks of its row
+ * and column, then all the others, the last two phases in parallel. Every
+ * block update keeps three BlockSize x BlockSize tiles in cache and its
+ * inner loop is a branchless min over contiguous rows that the compiler
+ * vectorizes. Value must be a floating point type so that the infinity of
+ * unreachable pairs absorbs additions.
+ */
+template <typename Value, std::size_t BlockSize = 64>
+class floyd_warshall {
+    static_assert(std::is_floating_point_v<Value>);
+
+public:
+    static constexpr Value infinity = std::numeric_limits<Value>::infinity();
+
+private:
+    std::size_t _nb_vertices;
+    std::size_t _nb_blocks;
+    std::size_t _stride;
+    std::vector<Value> _matrix;
+
+public:
+    template <typename Graph, typename LengthMap>
+    [[nodiscard]] floyd_warshall(const Graph & g, const LengthMap & l)
+        : _nb_vertices(g.nb_vertices())
+        , _nb_blocks((g.nb_vertices() + BlockSize - 1) / BlockSize)
+        , _stride(_nb_blocks * BlockSize)
+        , _matrix(_stride * _stride, infinity) {
+        for(std::size_t u = 0; u < _stride; ++u) _matrix[u * _stride + u] = 0;
+        for(auto && a : g.arcs()) {
+            Value & d = _matrix[g.arc_source(a) * _stride + g.arc_target(a)];
+            d = std::min(d, static_cast<Value>(l[a]));
+        }
+    }
+
+    [[nodiscard]] std::size_t nb_vertices() const noexcept {
+        return _nb_vertices;
+    }
+    [[nodiscard]] Value dist(const std::size_t u,
+                             const std::size_t v) const noexcept {
+        return _matrix[u * _stride + v];
+    }
+    [[nodiscard]] std::size_t memory_bytes() const noexcept {
+        return _matrix.size() * sizeof(Value);
+    }
+
+    void run(const std::size_t nb_threads) {
+        const std::size_t nb_workers = std::max(nb_threads, std::size_t{1});
+        for(std::size_t kb = 0; kb < _nb_blocks; ++kb) {
+            update_block(kb, kb, kb);
+            // blocks of the row and of the column of the diagonal block
+            parallel_for(2 * (_nb_blocks - 1), nb_workers,
+                         [this, kb](const std::size_t task) {
+                             std::size_t b = task / 2;
+                             if(b >= kb) ++b;
+                             if(task % 2 == 0)
+                                 update_block(kb, b, kb);
+                             else
+                                 update_block(b, kb, kb);
+                         });
+            // remaining blocks, one block row per task
+            parallel_for(_nb_blocks, nb_workers,
+                         [this, kb](const std::size_t ib) {
+                             if(ib == kb) return;
+                             for(std::size_t jb = 0; jb < _nb_blocks; ++jb)
+                                 if(jb != kb) update_block(ib, jb, kb);
+                         });
+        }
+    }
+
+    // Writes the number of vertices as a 64 bits integer followed by the
+    // unpadded matrix in row major order
+    void write_binary(std::ostream & os) const {
+        const std::uint64_t n = _nb_vertices;
+        os.write(reinterpret_cast<const char *>(&n), sizeof(n));
+        const auto row_size =
+            static_cast<std::streamsize>(_nb_vertices * sizeof(Value));
+        for(std::size_t u = 0; u < _nb_vertices; ++u)
+            os.write(reinterpret_cast<const char *>(&_matrix[u * _stride]),
+                     row_size);
+    }
+
+private:
+    template <typename F>
+    static void parallel_for(const std::size_t nb_tasks,
+                             const std::size_t nb_workers, F && f) {
+        std::atomic<std::size_t> next_task = 0;
+        auto work = [&]() {
+            for(;;) {
+                const std::size_t task =
+                    next_task.fetch_add(1, std::memory_order_relaxed);
+                if(task >= nb_tasks) break;
+                f(task);
+            }
+        };
+        std::vector<std::thread> threads;
+        for(std::size_t t = 1; t < std::min(nb_workers, nb_tasks); ++t)
+            threads.emplace_back(work);
+        work();
+        for(auto & thread : threads) thread.join();
+    }
+
+    // Relaxes the block (ib, jb) through the pivots of the block kb
+    void update_block(const std::size_t ib, const std::size_t jb,
+                      const std::size_t kb) noexcept {
+        Value * const matrix = _matrix.data();
+        for(std::size_t k = kb * BlockSize; k < (kb + 1) * BlockSize; ++k) {
+            const Value * const row_k = matrix + k * _stride + jb * BlockSize;
+            for(std::size_t i = ib * BlockSize; i < (ib + 1) * BlockSize;
+                ++i) {
+                Value * const row_i = matrix + i * _stride + jb * BlockSize;
+                const Value d_ik = matrix[i * _stride + k];
+                if(d_ik == infinity) continue;
+                for(std::size_t j = 0; j < BlockSize; ++j) {
+                    const Value d = d_ik + row_k[j];
+                    row_i[j] = d < row_i[j] ? d : row_i[j];
+                }
+            }
+        }
+    }
+};
+
+#endif  // FLOYD_WARSHALL_HPP
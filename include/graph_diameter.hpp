@@ -0,0 +1,194 @@
+#ifndef GRAPH_DIAMETER_HPP
+#define GRAPH_DIAMETER_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+#include "melon/container/static_digraph.hpp"
+
+#include "dispatching_sssp.hpp"
+
+/**
+ * @brief Diameter and radius of the connected component of a vertex, by
+ * single source searches from a few well chosen vertices.
+ *
+ * The searches are run by dispatching_sssp, hence are breadth first searches
+ * for unit lengths and Dijkstra's algorithm otherwise. The graph must be
+ * symmetric, every arc u->v having a reverse arc v->u of the same length,
+ * so that distances satisfy d(u,w) <= d(u,v) + d(v,w) and
+ * d(u,w) >= |d(u,v) - d(v,w)|. Three methods are provided:
+ * - double_sweep: the eccentricity of a vertex farthest from the start, a
+ *   lower bound on the diameter after two searches;
+ * - ifub (Crescenzi et al.): from a central vertex u, the vertices are
+ *   searched by decreasing distance to u until the diameter lower bound
+ *   reaches twice the distance of the next one, which bounds the distance
+ *   between any two remaining vertices;
+ * - bounding_diameters (Takes and Kosters): lower and upper bounds on the
+ *   eccentricity of every vertex are tightened by the distances of each
+ *   search, alternately from the vertex of largest upper bound and from the
+ *   vertex of smallest lower bound, until no vertex can change the bounds
+ *   on the diameter or the radius.
+ */
+template <typename Graph, typename LengthMap,
+          length_class Class = length_class::unknown>
+class graph_diameter {
+public:
+    using vertex = fhamonic::melon::vertex_t<Graph>;
+    using sssp = dispatching_sssp<Graph, LengthMap, Class>;
+    using value_t = typename sssp::value_t;
+
+private:
+    static constexpr value_t infinity = std::numeric_limits<value_t>::max();
+
+    std::reference_wrapper<const Graph> _graph;
+    sssp _sssp;
+    std::size_t _nb_searches;
+    std::vector<vertex> _component;
+    // distances from the last searched vertex, indexed like _component
+    std::vector<value_t> _dist_map;
+
+public:
+    [[nodiscard]] graph_diameter(const Graph & g, const LengthMap & l)
+        : _graph(std::cref(g)), _sssp(g, l), _nb_searches(0) {}
+    // the length map is kept by reference
+    graph_diameter(const Graph &, LengthMap &&) = delete;
+
+    // number of searches of the last computation
+    [[nodiscard]] std::size_t nb_searches() const noexcept {
+        return _nb_searches;
+    }
+    // number of vertices of the component of the last computation
+    [[nodiscard]] std::size_t component_size() const noexcept {
+        return _component.size();
+    }
+
+    // Lower bound on the diameter of the component of s
+    [[nodiscard]] value_t double_sweep(const vertex s) {
+        explore_component(s);
+        search(farthest());
+        return eccentricity();
+    }
+
+    // Diameter of the component of s
+    [[nodiscard]] value_t ifub(const vertex s) {
+        explore_component(s);
+        // the center u of a double sweep a -> b minimizes max(d(a,u),d(b,u))
+        search(farthest());
+        std::vector<value_t> a_dist_map = _dist_map;
+        value_t lower_bound = eccentricity();
+        search(farthest());
+        lower_bound = std::max(lower_bound, eccentricity());
+        std::size_t u = 0;
+        for(std::size_t i = 1; i < _component.size(); ++i)
+            if(std::max(a_dist_map[i], _dist_map[i]) <
+               std::max(a_dist_map[u], _dist_map[u]))
+                u = i;
+        search(u);
+        lower_bound = std::max(lower_bound, eccentricity());
+
+        std::vector<std::pair<value_t, std::size_t>> fringe;
+        fringe.reserve(_component.size());
+        for(std::size_t i = 0; i < _component.size(); ++i)
+            fringe.emplace_back(_dist_map[i], i);
+        std::sort(fringe.begin(), fringe.end(), std::greater<>());
+        for(auto && [u_dist, i] : fringe) {
+            // every remaining pair is within u_dist + u_dist of each other
+            if(lower_bound >= u_dist + u_dist) break;
+            search(i);
+            lower_bound = std::max(lower_bound, eccentricity());
+        }
+        return lower_bound;
+    }
+
+    // Diameter and radius of the component of s
+    [[nodiscard]] std::pair<value_t, value_t> bounding_diameters(
+        const vertex s) {
+        const Graph & g = _graph.get();
+        explore_component(s);
+        const std::size_t nb_vertices = _component.size();
+        std::vector<value_t> ecc_lower(nb_vertices, value_t{0});
+        std::vector<value_t> ecc_upper(nb_vertices, infinity);
+        std::vector<std::size_t> degree(nb_vertices);
+        for(std::size_t i = 0; i < nb_vertices; ++i)
+            degree[i] = static_cast<std::size_t>(
+                std::ranges::distance(g.out_arcs(_component[i])));
+        std::vector<std::size_t> candidates(nb_vertices);
+        for(std::size_t i = 0; i < nb_vertices; ++i) candidates[i] = i;
+
+        value_t diameter_lower = 0;
+        value_t radius_upper = infinity;
+        for(bool select_upper = true;; select_upper = !select_upper) {
+            const value_t ecc = eccentricity();
+            diameter_lower = std::max(diameter_lower, ecc);
+            radius_upper = std::min(radius_upper, ecc);
+            for(const std::size_t w : candidates) {
+                const value_t d = _dist_map[w];
+                ecc_lower[w] = std::max(ecc_lower[w], std::max(d, ecc - d));
+                ecc_upper[w] = std::min(ecc_upper[w], ecc + d);
+                diameter_lower = std::max(diameter_lower, ecc_lower[w]);
+                radius_upper = std::min(radius_upper, ecc_upper[w]);
+            }
+            // a vertex stays a candidate while its eccentricity can exceed
+            // the diameter lower bound or go below the radius upper bound,
+            // the searched vertex, whose bounds are equal, is always removed
+            std::erase_if(candidates, [&](const std::size_t w) {
+                return ecc_upper[w] <= diameter_lower &&
+                       ecc_lower[w] >= radius_upper;
+            });
+            if(candidates.empty()) break;
+
+            auto better = [&](const std::size_t v, const std::size_t w) {
+                if(select_upper) {
+                    if(ecc_upper[v] != ecc_upper[w])
+                        return ecc_upper[v] > ecc_upper[w];
+                } else if(ecc_lower[v] != ecc_lower[w]) {
+                    return ecc_lower[v] < ecc_lower[w];
+                }
+                return degree[v] > degree[w];
+            };
+            search(*std::min_element(candidates.begin(), candidates.end(),
+                                     better));
+        }
+        return {diameter_lower, radius_upper};
+    }
+
+private:
+    void explore_component(const vertex s) {
+        _nb_searches = 1;
+        _sssp.run(s);
+        _component.clear();
+        _dist_map.clear();
+        for(auto && u : _graph.get().vertices()) {
+            if(!_sssp.reached(u)) continue;
+            _component.push_back(u);
+            _dist_map.push_back(_sssp.dist(u));
+        }
+    }
+    void search(const std::size_t i) {
+        ++_nb_searches;
+        _sssp.run(_component[i]);
+        for(std::size_t j = 0; j < _component.size(); ++j) {
+            assert(_sssp.reached(_component[j]));
+            _dist_map[j] = _sssp.dist(_component[j]);
+        }
+    }
+    // index of the farthest vertex from the last searched vertex
+    [[nodiscard]] std::size_t farthest() const noexcept {
+        return static_cast<std::size_t>(
+            std::max_element(_dist_map.begin(), _dist_map.end()) -
+            _dist_map.begin());
+    }
+    // eccentricity of the last searched vertex
+    [[nodiscard]] value_t eccentricity() const noexcept {
+        return _dist_map[farthest()];
+    }
+};
+
+#endif  // GRAPH_DIAMETER_HPP
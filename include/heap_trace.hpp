@@ -0,0 +1,101 @@
+#ifndef HEAP_TRACE_HPP
+#define HEAP_TRACE_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * Binary traces of the heap operations of a shortest path algorithm.
+ *
+ * A trace file starts with the magic number, the number of ids and the
+ * number of operations, stored as little endian 64 bits integers, followed
+ * by the operations as packed triples of 32 bits integers. Pop operations
+ * record the priority of the extracted entry so that a replay can check the
+ * heap, and clear operations separate the runs of the algorithm.
+ */
+
+enum class heap_operation_type : std::uint32_t { push, promote, pop, clear };
+
+struct heap_operation {
+    heap_operation_type type;
+    std::uint32_t id;
+    std::uint32_t priority;
+};
+static_assert(sizeof(heap_operation) == 12);
+
+struct heap_trace {
+    std::uint64_t nb_ids = 0;
+    std::vector<heap_operation> operations;
+};
+
+inline constexpr std::uint64_t heap_trace_magic = 0x3130435254504548;  // HEPTRC01
+
+inline void write_heap_trace(const std::filesystem::path & file_name,
+                             const heap_trace & trace) {
+    std::ofstream file(file_name, std::ios::binary);
+    const std::uint64_t header[3] = {heap_trace_magic, trace.nb_ids,
+                                     trace.operations.size()};
+    file.write(reinterpret_cast<const char *>(header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(trace.operations.data()),
+               static_cast<std::streamsize>(trace.operations.size() *
+                                            sizeof(heap_operation)));
+    if(!file) throw std::runtime_error("cannot write " + file_name.string());
+}
+
+inline heap_trace read_heap_trace(const std::filesystem::path & file_name) {
+    std::ifstream file(file_name, std::ios::binary);
+    std::uint64_t header[3];
+    file.read(reinterpret_cast<char *>(header), sizeof(header));
+    if(!file || header[0] != heap_trace_magic)
+        throw std::runtime_error(file_name.string() + " is not a heap trace");
+    heap_trace trace;
+    trace.nb_ids = header[1];
+    trace.operations.resize(header[2]);
+    file.read(reinterpret_cast<char *>(trace.operations.data()),
+              static_cast<std::streamsize>(trace.operations.size() *
+                                           sizeof(heap_operation)));
+    if(!file) throw std::runtime_error(file_name.string() + " is truncated");
+    return trace;
+}
+
+/**
+ * @brief Heap adaptor appending its push, promote and pop operations to a
+ * trace.
+ *
+ * Like counting_heap, the heap is built by the algorithm that uses it, so
+ * the trace is a static member that the recorder reads after the runs.
+ */
+template <typename Heap>
+class tracing_heap : public Heap {
+public:
+    static inline heap_trace trace;
+
+    using Heap::Heap;
+
+    constexpr void push(const typename Heap::id_type & id,
+                        const typename Heap::priority_type & p) {
+        trace.operations.push_back({heap_operation_type::push,
+                                    static_cast<std::uint32_t>(id),
+                                    static_cast<std::uint32_t>(p)});
+        Heap::push(id, p);
+    }
+    constexpr void promote(const typename Heap::id_type & id,
+                           const typename Heap::priority_type & p) {
+        trace.operations.push_back({heap_operation_type::promote,
+                                    static_cast<std::uint32_t>(id),
+                                    static_cast<std::uint32_t>(p)});
+        Heap::promote(id, p);
+    }
+    constexpr void pop() {
+        const auto top = Heap::top();
+        trace.operations.push_back({heap_operation_type::pop,
+                                    static_cast<std::uint32_t>(top.first),
+                                    static_cast<std::uint32_t>(top.second)});
+        Heap::pop();
+    }
+};
+
+#endif  // HEAP_TRACE_HPP
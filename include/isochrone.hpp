@@ -0,0 +1,37 @@
+#ifndef ISOCHRONE_HPP
+#define ISOCHRONE_HPP
+
+#include <utility>
+#include <vector>
+
+/**
+ * Radius bounded search: advances a Dijkstra-like search, melon's dijkstra
+ * or a dijkstra_workspace whose sources are already added, until the
+ * minimum of its heap exceeds the radius. The settled vertices and their
+ * distances are written in reached_entries, then the frontier arcs, the arcs
+ * leaving a reached vertex that cannot be entirely traversed within the
+ * radius, are written in frontier_arcs. Both buffers are cleared first and
+ * keep their capacity from one call to the next.
+ */
+template <typename Search, typename Graph, typename LengthMap, typename Value,
+          typename Vertex, typename Arc>
+void isochrone_search(Search & search, const Graph & g, const LengthMap & l,
+                      const Value radius,
+                      std::vector<std::pair<Vertex, Value>> & reached_entries,
+                      std::vector<Arc> & frontier_arcs) {
+    reached_entries.clear();
+    frontier_arcs.clear();
+    while(!search.finished()) {
+        const auto entry = search.current();
+        if(entry.second > radius) break;
+        reached_entries.emplace_back(entry.first, entry.second);
+        search.advance();
+    }
+    for(auto && [u, u_dist] : reached_entries) {
+        for(auto && a : g.out_arcs(u)) {
+            if(u_dist + l[a] > radius) frontier_arcs.push_back(a);
+        }
+    }
+}
+
+#endif  // ISOCHRONE_HPP
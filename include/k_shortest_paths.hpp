@@ -0,0 +1,361 @@
+#ifndef K_SHORTEST_PATHS_HPP
+#define K_SHORTEST_PATHS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "melon/algorithm/dijkstra.hpp"
+#include "melon/container/d_ary_heap.hpp"
+#include "melon/container/static_digraph.hpp"
+
+#include "dijkstra_workspace.hpp"
+
+/**
+ * @brief k shortest loopless paths by Yen's algorithm with Lawler's
+ * deviation indices.
+ *
+ * A query starts with a reverse Dijkstra from t, stopped once its radius
+ * exceeds twice the distance from s, whose distances (capped by the final
+ * radius) form a consistent potential. The first path is read from this
+ * reverse tree. For each accepted path, a spur path is searched from every
+ * vertex after the point where the path deviated from its parent, avoiding
+ * the root vertices and the arcs that the accepted paths with the same root
+ * take next. When the best allowed arc of the spur vertex, measured by the
+ * potential, leads to a reverse tree path that avoids the root, this path
+ * is optimal and no search is needed. Otherwise the spur path comes from
+ * an A* search, run by a reused dijkstra_workspace on the lengths reduced
+ * by the potential. The candidates wait in a heap ordered by length.
+ */
+template <typename Graph, typename LengthMap>
+class k_shortest_paths {
+public:
+    using vertex = fhamonic::melon::vertex_t<Graph>;
+    using arc = fhamonic::melon::arc_t<Graph>;
+    using value_t = std::decay_t<decltype(std::declval<const LengthMap &>()[
+        std::declval<arc>()])>;
+    struct path {
+        value_t length;
+        std::size_t deviation_index;
+        std::vector<vertex> vertices;
+        std::vector<arc> arcs;
+    };
+
+private:
+    static constexpr value_t infinity = std::numeric_limits<value_t>::max();
+    static constexpr value_t potential_radius_factor = 2;
+
+    struct reduced_length_map {
+        const k_shortest_paths * ksp;
+        [[nodiscard]] value_t operator[](const arc & a) const noexcept {
+            return ksp->reduced_length(a);
+        }
+    };
+    struct spur_traits {
+        using semiring = fhamonic::melon::shortest_path_semiring<value_t>;
+        using heap = fhamonic::melon::d_ary_heap<
+            2, vertex, value_t,
+            decltype([](const auto & e1, const auto & e2) {
+                return semiring::less(e1.second, e2.second);
+            }),
+            fhamonic::melon::vertex_map_t<Graph, std::size_t>>;
+
+        static constexpr bool store_paths = true;
+        static constexpr bool store_distances = false;
+    };
+    using reverse_heap = fhamonic::melon::d_ary_heap<
+        4, vertex, value_t,
+        decltype([](const auto & e1, const auto & e2) {
+            return e1.second < e2.second;
+        }),
+        fhamonic::melon::vertex_map_t<Graph, std::size_t>>;
+
+    std::reference_wrapper<const Graph> _graph;
+    std::reference_wrapper<const LengthMap> _length_map;
+
+    // reverse search from t: 2*generation in heap, 2*generation+1 settled
+    reverse_heap _reverse_heap;
+    std::vector<std::uint32_t> _reverse_stamp_map;
+    std::uint32_t _reverse_in_heap_stamp;
+    std::vector<value_t> _potential_map;
+    std::vector<arc> _next_arc_map;
+    value_t _potential_radius;
+
+    reduced_length_map _reduced_length_map;
+    dijkstra_workspace<Graph, reduced_length_map, spur_traits> _spur_search;
+    std::vector<std::uint32_t> _blocked_stamp_map;
+    std::uint32_t _blocked_stamp;
+    std::vector<arc> _blocked_arcs;
+
+    std::vector<path> _paths;
+    std::vector<path> _candidates;
+    std::vector<std::size_t> _same_root_paths;
+    std::size_t _nb_dijkstra_runs;
+    std::size_t _nb_tree_spurs;
+
+public:
+    [[nodiscard]] k_shortest_paths(const Graph & g, const LengthMap & l)
+        : _graph(std::cref(g))
+        , _length_map(std::cref(l))
+        , _reverse_heap(fhamonic::melon::create_vertex_map<std::size_t>(g))
+        , _reverse_stamp_map(g.nb_vertices(), 0)
+        , _reverse_in_heap_stamp(0)
+        , _potential_map(g.nb_vertices())
+        , _next_arc_map(g.nb_vertices())
+        , _potential_radius(infinity)
+        , _reduced_length_map{this}
+        , _spur_search(spur_traits{}, g, _reduced_length_map)
+        , _blocked_stamp_map(g.nb_vertices(), 0)
+        , _blocked_stamp(0)
+        , _nb_dijkstra_runs(0)
+        , _nb_tree_spurs(0) {}
+
+    k_shortest_paths(const k_shortest_paths &) = delete;
+    k_shortest_paths & operator=(const k_shortest_paths &) = delete;
+
+    // paths found by the last query, by increasing length
+    [[nodiscard]] const std::vector<path> & paths() const noexcept {
+        return _paths;
+    }
+    // reverse search and A* spur searches of the last query
+    [[nodiscard]] std::size_t nb_dijkstra_runs() const noexcept {
+        return _nb_dijkstra_runs;
+    }
+    // spur paths of the last query read from the reverse tree
+    [[nodiscard]] std::size_t nb_tree_spurs() const noexcept {
+        return _nb_tree_spurs;
+    }
+
+private:
+    static bool longer(const path & p1, const path & p2) noexcept {
+        return p1.length > p2.length;
+    }
+    [[nodiscard]] bool reverse_settled(const vertex u) const noexcept {
+        return _reverse_stamp_map[u] == _reverse_in_heap_stamp + 1;
+    }
+    [[nodiscard]] value_t potential(const vertex u) const noexcept {
+        return reverse_settled(u) ? _potential_map[u] : _potential_radius;
+    }
+    [[nodiscard]] value_t reduced_length(const arc & a) const noexcept {
+        const Graph & g = _graph.get();
+        return _length_map.get()[a] + potential(g.arc_target(a)) -
+               potential(g.arc_source(a));
+    }
+
+    void reverse_search(const vertex s, const vertex t) {
+        const Graph & g = _graph.get();
+        const LengthMap & l = _length_map.get();
+        _reverse_heap.clear();
+        if(_reverse_in_heap_stamp >=
+           std::numeric_limits<std::uint32_t>::max() - 2) {
+            std::fill(_reverse_stamp_map.begin(), _reverse_stamp_map.end(),
+                      0);
+            _reverse_in_heap_stamp = 0;
+        }
+        _reverse_in_heap_stamp += 2;
+        ++_nb_dijkstra_runs;
+
+        _reverse_heap.push(t, value_t{0});
+        _reverse_stamp_map[t] = _reverse_in_heap_stamp;
+        value_t radius_bound = infinity;
+        while(!_reverse_heap.empty()) {
+            const auto [u, u_dist] = _reverse_heap.top();
+            if(u_dist > radius_bound) break;
+            _reverse_heap.pop();
+            _reverse_stamp_map[u] = _reverse_in_heap_stamp + 1;
+            _potential_map[u] = u_dist;
+            if(u == s) radius_bound = potential_radius_factor * u_dist;
+            for(auto && a : g.in_arcs(u)) {
+                const vertex w = g.arc_source(a);
+                const std::uint32_t w_stamp = _reverse_stamp_map[w];
+                const value_t new_dist = u_dist + l[a];
+                if(w_stamp == _reverse_in_heap_stamp) {
+                    if(new_dist < _reverse_heap.priority(w)) {
+                        _reverse_heap.promote(w, new_dist);
+                        _next_arc_map[w] = a;
+                    }
+                } else if(w_stamp < _reverse_in_heap_stamp) {
+                    _reverse_heap.push(w, new_dist);
+                    _reverse_stamp_map[w] = _reverse_in_heap_stamp;
+                    _next_arc_map[w] = a;
+                }
+            }
+        }
+        // the unsettled vertices are at least as far as the radius
+        _potential_radius =
+            _reverse_heap.empty() ? infinity : _reverse_heap.top().second;
+    }
+
+    [[nodiscard]] bool blocked(const vertex u) const noexcept {
+        return _blocked_stamp_map[u] == _blocked_stamp;
+    }
+    [[nodiscard]] bool is_allowed(const arc & a) const noexcept {
+        const vertex w = _graph.get().arc_target(a);
+        return !blocked(w) && potential(w) != infinity &&
+               std::find(_blocked_arcs.begin(), _blocked_arcs.end(), a) ==
+                   _blocked_arcs.end();
+    }
+    void new_blocked_stamp() {
+        if(++_blocked_stamp == 0) {
+            std::fill(_blocked_stamp_map.begin(), _blocked_stamp_map.end(),
+                      0);
+            _blocked_stamp = 1;
+        }
+    }
+
+    // Appends to p the reverse tree path from u to t
+    void append_tree_path(path & p, vertex u, const vertex t) const {
+        const Graph & g = _graph.get();
+        while(u != t) {
+            const arc a = _next_arc_map[u];
+            u = g.arc_target(a);
+            p.arcs.push_back(a);
+            p.vertices.push_back(u);
+        }
+    }
+    [[nodiscard]] bool tree_path_avoids_root(vertex u,
+                                             const vertex t) const noexcept {
+        const Graph & g = _graph.get();
+        while(u != t) {
+            if(blocked(u)) return false;
+            u = g.arc_target(_next_arc_map[u]);
+        }
+        return true;
+    }
+
+    // Completes the root path p, ending at the spur vertex v, with a
+    // shortest allowed path to t and returns false if there is none
+    [[nodiscard]] bool complete_spur_path(path & p, const vertex v,
+                                          const vertex t) {
+        const Graph & g = _graph.get();
+        const LengthMap & l = _length_map.get();
+        value_t best_bound = infinity;
+        arc best_arc{};
+        for(auto && a : g.out_arcs(v)) {
+            if(!is_allowed(a)) continue;
+            const value_t bound = l[a] + potential(g.arc_target(a));
+            if(bound < best_bound) {
+                best_bound = bound;
+                best_arc = a;
+            }
+        }
+        if(best_bound == infinity) return false;
+        const vertex w = g.arc_target(best_arc);
+        if(reverse_settled(w) && tree_path_avoids_root(w, t)) {
+            ++_nb_tree_spurs;
+            p.length += best_bound;
+            p.arcs.push_back(best_arc);
+            p.vertices.push_back(w);
+            append_tree_path(p, w, t);
+            return true;
+        }
+
+        ++_nb_dijkstra_runs;
+        _spur_search.reset();
+        _spur_search.add_source(v);
+        while(!_spur_search.finished()) {
+            const auto [u, u_reduced_dist] = _spur_search.current();
+            if(u == t) {
+                p.length += u_reduced_dist + potential(v);
+                const std::size_t root_size = p.vertices.size();
+                for(vertex x = t; x != v;) {
+                    const arc a = _spur_search.pred_arc(x);
+                    p.arcs.push_back(a);
+                    p.vertices.push_back(x);
+                    x = g.arc_source(a);
+                }
+                std::reverse(p.arcs.begin() + static_cast<std::ptrdiff_t>(
+                                                  root_size - 1),
+                             p.arcs.end());
+                std::reverse(p.vertices.begin() +
+                                 static_cast<std::ptrdiff_t>(root_size),
+                             p.vertices.end());
+                return true;
+            }
+            _spur_search.advance(
+                [this](const arc & a) { return is_allowed(a); });
+        }
+        return false;
+    }
+
+    // Pushes the deviations of the last accepted path in the candidates
+    void add_deviations(const vertex t) {
+        const path & last = _paths.back();
+        const LengthMap & l = _length_map.get();
+        _same_root_paths.resize(_paths.size());
+        for(std::size_t j = 0; j < _paths.size(); ++j) _same_root_paths[j] = j;
+        new_blocked_stamp();
+        value_t root_length = value_t{0};
+        for(std::size_t i = 0; i + 1 < last.vertices.size(); ++i) {
+            if(i > 0) {
+                root_length += l[last.arcs[i - 1]];
+                std::erase_if(_same_root_paths, [&](const std::size_t j) {
+                    return _paths[j].arcs.size() < i ||
+                           _paths[j].arcs[i - 1] != last.arcs[i - 1];
+                });
+            }
+            const vertex v = last.vertices[i];
+            _blocked_stamp_map[v] = _blocked_stamp;
+            if(i < last.deviation_index) continue;
+
+            _blocked_arcs.clear();
+            for(const std::size_t j : _same_root_paths)
+                if(_paths[j].arcs.size() > i)
+                    _blocked_arcs.push_back(_paths[j].arcs[i]);
+
+            path candidate{root_length, i, {}, {}};
+            candidate.vertices.assign(
+                last.vertices.begin(),
+                last.vertices.begin() + static_cast<std::ptrdiff_t>(i + 1));
+            candidate.arcs.assign(
+                last.arcs.begin(),
+                last.arcs.begin() + static_cast<std::ptrdiff_t>(i));
+            if(!complete_spur_path(candidate, v, t)) continue;
+            _candidates.push_back(std::move(candidate));
+            std::push_heap(_candidates.begin(), _candidates.end(), longer);
+        }
+    }
+
+    // Moves the shortest candidate to the accepted paths, skipping the
+    // paths generated again from a sibling deviation
+    [[nodiscard]] bool accept_next_candidate() {
+        while(!_candidates.empty()) {
+            std::pop_heap(_candidates.begin(), _candidates.end(), longer);
+            path p = std::move(_candidates.back());
+            _candidates.pop_back();
+            if(std::any_of(_paths.begin(), _paths.end(),
+                           [&p](const path & q) { return q.arcs == p.arcs; }))
+                continue;
+            _paths.push_back(std::move(p));
+            return true;
+        }
+        return false;
+    }
+
+public:
+    // Finds up to k shortest loopless paths from s to t
+    void run(const vertex s, const vertex t, const std::size_t k) {
+        _paths.clear();
+        _candidates.clear();
+        _nb_dijkstra_runs = 0;
+        _nb_tree_spurs = 0;
+        if(k == 0) return;
+        reverse_search(s, t);
+        if(!reverse_settled(s)) return;
+
+        path first{_potential_map[s], 0, {s}, {}};
+        append_tree_path(first, s, t);
+        _paths.push_back(std::move(first));
+        while(_paths.size() < k) {
+            add_deviations(t);
+            if(!accept_next_candidate()) break;
+        }
+    }
+};
+
+#endif  // K_SHORTEST_PATHS_HPP
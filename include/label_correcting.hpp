@@ -0,0 +1,390 @@
+#ifndef LABEL_CORRECTING_HPP
+#define LABEL_CORRECTING_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "melon/container/static_digraph.hpp"
+
+/**
+ * Searches a cycle in the graph of the predecessor arcs, in which every
+ * vertex has at most one outgoing arc, by walking from every vertex until a
+ * root, an already explored vertex or a vertex of the current walk. During
+ * a label correcting algorithm, such a cycle has a negative length. Returns
+ * the arcs of the cycle in path order, or an empty vector.
+ */
+template <typename Graph, typename Vertex, typename Arc>
+std::vector<Arc> find_predecessor_cycle(const Graph & g,
+                                        const std::vector<Arc> & pred_arcs,
+                                        const std::vector<char> & has_pred,
+                                        std::vector<std::uint32_t> & walk_map) {
+    const std::size_t n = pred_arcs.size();
+    std::fill(walk_map.begin(), walk_map.end(), 0);
+    std::uint32_t walk = 0;
+    for(std::size_t s = 0; s < n; ++s) {
+        if(walk_map[s] != 0) continue;
+        ++walk;
+        Vertex u = static_cast<Vertex>(s);
+        while(walk_map[u] == 0 && has_pred[u]) {
+            walk_map[u] = walk;
+            u = g.arc_source(pred_arcs[u]);
+        }
+        if(walk_map[u] != walk) {
+            walk_map[u] = walk;
+            continue;
+        }
+        std::vector<Arc> cycle;
+        Vertex v = u;
+        do {
+            cycle.push_back(pred_arcs[v]);
+            v = g.arc_source(pred_arcs[v]);
+        } while(v != u);
+        std::reverse(cycle.begin(), cycle.end());
+        return cycle;
+    }
+    return {};
+}
+
+/**
+ * @brief FIFO label correcting shortest paths (Bellman-Ford-Moore) with
+ * parent checking and negative cycle detection.
+ *
+ * A vertex leaving the queue is not scanned when the source of its
+ * predecessor arc is back in the queue, since its label will be improved
+ * anyway. Every n scans, the predecessor graph is searched for a cycle and
+ * the run stops as soon as one is found.
+ */
+template <typename Graph, typename LengthMap>
+class spfa {
+public:
+    using vertex = fhamonic::melon::vertex_t<Graph>;
+    using arc = fhamonic::melon::arc_t<Graph>;
+    using value_t = std::decay_t<decltype(std::declval<const LengthMap &>()[
+        std::declval<arc>()])>;
+
+private:
+    std::reference_wrapper<const Graph> _graph;
+    std::reference_wrapper<const LengthMap> _length_map;
+    std::vector<value_t> _dist_map;
+    std::vector<arc> _pred_arcs_map;
+    std::vector<char> _has_pred_map;
+    std::vector<char> _reached_map;
+    std::vector<char> _in_queue_map;
+    std::vector<vertex> _queue;  // circular, holds each vertex at most once
+    std::vector<std::uint32_t> _walk_map;
+    std::vector<arc> _negative_cycle;
+    std::size_t _nb_scans;
+
+public:
+    [[nodiscard]] spfa(const Graph & g, const LengthMap & l)
+        : _graph(std::cref(g))
+        , _length_map(std::cref(l))
+        , _dist_map(g.nb_vertices())
+        , _pred_arcs_map(g.nb_vertices())
+        , _has_pred_map(g.nb_vertices(), false)
+        , _reached_map(g.nb_vertices(), false)
+        , _in_queue_map(g.nb_vertices(), false)
+        , _queue(g.nb_vertices() + 1)
+        , _walk_map(g.nb_vertices())
+        , _negative_cycle()
+        , _nb_scans(0) {}
+
+    [[nodiscard]] bool reached(const vertex u) const noexcept {
+        return _reached_map[u];
+    }
+    [[nodiscard]] value_t dist(const vertex u) const noexcept {
+        assert(reached(u));
+        return _dist_map[u];
+    }
+    [[nodiscard]] arc pred_arc(const vertex u) const noexcept {
+        assert(_has_pred_map[u]);
+        return _pred_arcs_map[u];
+    }
+    [[nodiscard]] std::size_t nb_scans() const noexcept { return _nb_scans; }
+    [[nodiscard]] bool has_negative_cycle() const noexcept {
+        return !_negative_cycle.empty();
+    }
+    [[nodiscard]] const std::vector<arc> & negative_cycle() const noexcept {
+        return _negative_cycle;
+    }
+
+    // Returns false if a negative cycle is reachable from s
+    bool run(const vertex s) {
+        const Graph & g = _graph.get();
+        const LengthMap & l = _length_map.get();
+        const std::size_t n = _dist_map.size();
+        std::fill(_has_pred_map.begin(), _has_pred_map.end(), false);
+        std::fill(_reached_map.begin(), _reached_map.end(), false);
+        std::fill(_in_queue_map.begin(), _in_queue_map.end(), false);
+        _negative_cycle.clear();
+        _nb_scans = 0;
+
+        std::size_t head = 0, tail = 0;
+        auto push = [&](const vertex v) {
+            _queue[tail] = v;
+            tail = (tail + 1 == _queue.size()) ? 0 : tail + 1;
+            _in_queue_map[v] = true;
+        };
+        _dist_map[s] = value_t{0};
+        _reached_map[s] = true;
+        push(s);
+        std::size_t next_cycle_check = n;
+        while(head != tail) {
+            const vertex u = _queue[head];
+            head = (head + 1 == _queue.size()) ? 0 : head + 1;
+            _in_queue_map[u] = false;
+            if(_has_pred_map[u] &&
+               _in_queue_map[g.arc_source(_pred_arcs_map[u])])
+                continue;
+            ++_nb_scans;
+            const value_t u_dist = _dist_map[u];
+            for(auto && a : g.out_arcs(u)) {
+                const vertex v = g.arc_target(a);
+                const value_t new_dist = u_dist + l[a];
+                if(_reached_map[v] && !(new_dist < _dist_map[v])) continue;
+                _dist_map[v] = new_dist;
+                _reached_map[v] = true;
+                _pred_arcs_map[v] = a;
+                _has_pred_map[v] = true;
+                if(!_in_queue_map[v]) push(v);
+            }
+            if(_nb_scans >= next_cycle_check) {
+                next_cycle_check += n;
+                _negative_cycle = find_predecessor_cycle<Graph, vertex, arc>(
+                    g, _pred_arcs_map, _has_pred_map, _walk_map);
+                if(has_negative_cycle()) return false;
+            }
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief Goldberg-Radzik label correcting shortest paths.
+ *
+ * The arcs are copied in a CSR. Each pass takes the labeled vertices that
+ * have an outgoing arc of negative reduced cost (d(u) + l(u,v) < d(v)),
+ * computes by a depth first search the vertices reachable from them by
+ * such arcs in topological order, and scans them in this order. The
+ * vertices whose label decreases are labeled for the next pass. An arc of
+ * negative reduced cost closing a cycle in the search reveals a negative
+ * cycle and stops the run, and the predecessor graph is also searched for a
+ * cycle every n scans.
+ */
+template <typename Graph, typename LengthMap>
+class goldberg_radzik {
+public:
+    using vertex = fhamonic::melon::vertex_t<Graph>;
+    using arc = fhamonic::melon::arc_t<Graph>;
+    using value_t = std::decay_t<decltype(std::declval<const LengthMap &>()[
+        std::declval<arc>()])>;
+
+private:
+    struct out_arc {
+        vertex target;
+        value_t length;
+        arc original;
+    };
+    struct dfs_frame {
+        vertex u;
+        std::size_t next_arc;
+    };
+
+    std::reference_wrapper<const Graph> _graph;
+    std::vector<std::size_t> _arcs_begin;
+    std::vector<out_arc> _arcs;
+    std::vector<value_t> _dist_map;
+    std::vector<arc> _pred_arcs_map;
+    std::vector<char> _has_pred_map;
+    std::vector<char> _reached_map;
+    std::vector<char> _labeled_map;
+    std::vector<vertex> _labeled;
+    std::vector<std::uint32_t> _visited_map;
+    std::uint32_t _pass;
+    std::vector<char> _on_stack_map;
+    std::vector<dfs_frame> _stack;
+    std::vector<vertex> _order;
+    std::vector<std::uint32_t> _walk_map;
+    std::vector<arc> _negative_cycle;
+    std::size_t _nb_scans;
+    std::size_t _nb_passes;
+
+public:
+    [[nodiscard]] goldberg_radzik(const Graph & g, const LengthMap & l)
+        : _graph(std::cref(g))
+        , _arcs_begin(g.nb_vertices() + 1)
+        , _arcs()
+        , _dist_map(g.nb_vertices())
+        , _pred_arcs_map(g.nb_vertices())
+        , _has_pred_map(g.nb_vertices(), false)
+        , _reached_map(g.nb_vertices(), false)
+        , _labeled_map(g.nb_vertices(), false)
+        , _visited_map(g.nb_vertices(), 0)
+        , _pass(0)
+        , _on_stack_map(g.nb_vertices(), false)
+        , _walk_map(g.nb_vertices())
+        , _nb_scans(0)
+        , _nb_passes(0) {
+        _arcs.reserve(g.nb_arcs());
+        for(auto && u : g.vertices()) {
+            _arcs_begin[u] = _arcs.size();
+            for(auto && a : g.out_arcs(u))
+                _arcs.push_back({g.arc_target(a), l[a], a});
+        }
+        _arcs_begin[g.nb_vertices()] = _arcs.size();
+    }
+
+    [[nodiscard]] bool reached(const vertex u) const noexcept {
+        return _reached_map[u];
+    }
+    [[nodiscard]] value_t dist(const vertex u) const noexcept {
+        assert(reached(u));
+        return _dist_map[u];
+    }
+    [[nodiscard]] arc pred_arc(const vertex u) const noexcept {
+        assert(_has_pred_map[u]);
+        return _pred_arcs_map[u];
+    }
+    [[nodiscard]] std::size_t nb_scans() const noexcept { return _nb_scans; }
+    [[nodiscard]] std::size_t nb_passes() const noexcept {
+        return _nb_passes;
+    }
+    [[nodiscard]] bool has_negative_cycle() const noexcept {
+        return !_negative_cycle.empty();
+    }
+    [[nodiscard]] const std::vector<arc> & negative_cycle() const noexcept {
+        return _negative_cycle;
+    }
+
+private:
+    [[nodiscard]] bool improves(const vertex u,
+                                const out_arc & a) const noexcept {
+        return !_reached_map[a.target] ||
+               _dist_map[u] + a.length < _dist_map[a.target];
+    }
+    [[nodiscard]] bool has_improving_arc(const vertex u) const noexcept {
+        for(std::size_t i = _arcs_begin[u]; i < _arcs_begin[u + 1]; ++i)
+            if(improves(u, _arcs[i])) return true;
+        return false;
+    }
+
+    // Appends to _order, in post order, the vertices reachable from s by
+    // improving arcs, and returns false if such an arc closes a cycle
+    [[nodiscard]] bool topological_search(const vertex s) {
+        _visited_map[s] = _pass;
+        _on_stack_map[s] = true;
+        _stack.push_back({s, _arcs_begin[s]});
+        while(!_stack.empty()) {
+            dfs_frame & frame = _stack.back();
+            if(frame.next_arc == _arcs_begin[frame.u + 1]) {
+                _on_stack_map[frame.u] = false;
+                _order.push_back(frame.u);
+                _stack.pop_back();
+                continue;
+            }
+            const out_arc & a = _arcs[frame.next_arc++];
+            if(!improves(frame.u, a)) continue;
+            if(_on_stack_map[a.target]) {
+                record_stack_cycle(a);
+                return false;
+            }
+            if(_visited_map[a.target] == _pass) continue;
+            _visited_map[a.target] = _pass;
+            // an unreached vertex has no label to compare its arcs with
+            if(!_reached_map[a.target]) {
+                _order.push_back(a.target);
+                continue;
+            }
+            _on_stack_map[a.target] = true;
+            _stack.push_back({a.target, _arcs_begin[a.target]});
+        }
+        return true;
+    }
+    void record_stack_cycle(const out_arc & closing_arc) {
+        _negative_cycle.clear();
+        std::size_t i = _stack.size();
+        while(_stack[i - 1].u != closing_arc.target) --i;
+        for(; i < _stack.size(); ++i) {
+            const std::size_t arc_index = _stack[i - 1].next_arc - 1;
+            _negative_cycle.push_back(_arcs[arc_index].original);
+        }
+        _negative_cycle.push_back(closing_arc.original);
+        for(const dfs_frame & frame : _stack) _on_stack_map[frame.u] = false;
+        _stack.clear();
+    }
+
+    void scan(const vertex u) {
+        ++_nb_scans;
+        _labeled_map[u] = false;
+        const value_t u_dist = _dist_map[u];
+        for(std::size_t i = _arcs_begin[u]; i < _arcs_begin[u + 1]; ++i) {
+            const out_arc & a = _arcs[i];
+            if(!improves(u, a)) continue;
+            _dist_map[a.target] = u_dist + a.length;
+            _reached_map[a.target] = true;
+            _pred_arcs_map[a.target] = a.original;
+            _has_pred_map[a.target] = true;
+            if(!_labeled_map[a.target]) {
+                _labeled_map[a.target] = true;
+                _labeled.push_back(a.target);
+            }
+        }
+    }
+
+public:
+    // Returns false if a negative cycle is reachable from s
+    bool run(const vertex s) {
+        const std::size_t n = _dist_map.size();
+        std::fill(_has_pred_map.begin(), _has_pred_map.end(), false);
+        std::fill(_reached_map.begin(), _reached_map.end(), false);
+        std::fill(_labeled_map.begin(), _labeled_map.end(), false);
+        _labeled.clear();
+        _negative_cycle.clear();
+        _nb_scans = 0;
+        _nb_passes = 0;
+
+        _dist_map[s] = value_t{0};
+        _reached_map[s] = true;
+        _labeled_map[s] = true;
+        _labeled.push_back(s);
+        std::size_t next_cycle_check = n;
+        std::vector<vertex> roots;
+        while(!_labeled.empty()) {
+            ++_nb_passes;
+            if(++_pass == 0) {
+                std::fill(_visited_map.begin(), _visited_map.end(), 0);
+                _pass = 1;
+            }
+            roots.clear();
+            for(const vertex u : _labeled)
+                if(_labeled_map[u] && has_improving_arc(u))
+                    roots.push_back(u);
+            for(const vertex u : _labeled) _labeled_map[u] = false;
+            _labeled.clear();
+
+            _order.clear();
+            for(const vertex u : roots) {
+                if(_visited_map[u] == _pass) continue;
+                if(!topological_search(u)) return false;
+            }
+            for(auto it = _order.rbegin(); it != _order.rend(); ++it)
+                scan(*it);
+
+            if(_nb_scans >= next_cycle_check) {
+                next_cycle_check = _nb_scans + n;
+                _negative_cycle = find_predecessor_cycle<Graph, vertex, arc>(
+                    _graph.get(), _pred_arcs_map, _has_pred_map, _walk_map);
+                if(has_negative_cycle()) return false;
+            }
+        }
+        return true;
+    }
+};
+
+#endif  // LABEL_CORRECTING_HPP
@@ -0,0 +1,154 @@
+#ifndef MULTI_SOURCE_BFS_HPP
+#define MULTI_SOURCE_BFS_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "melon/container/static_digraph.hpp"
+
+/**
+ * @brief Bit parallel multi-source breadth first search (MS-BFS, Then et
+ * al.) running up to 64 * Words searches in one traversal of the graph.
+ *
+ * Each vertex holds three bitsets with one bit per source: seen, visit (the
+ * searches whose frontier contains the vertex) and visit_next. A level
+ * ORs the visit bitset of every vertex into the visit_next bitsets of its
+ * out neighbors, then removes the seen bits, so that the adjacency of a
+ * vertex is read once for all the searches that reach it at the same
+ * level. The bitset operations are loops over Words words that the compiler
+ * vectorizes. The searches accumulate, per source, the number of reached
+ * vertices and the sum of their distances, from which closeness is derived.
+ */
+template <typename Graph, std::size_t Words = 1>
+class multi_source_bfs {
+public:
+    using vertex = fhamonic::melon::vertex_t<Graph>;
+    static constexpr std::size_t max_nb_sources = 64 * Words;
+
+private:
+    struct alignas(8 * Words) bitset {
+        std::array<std::uint64_t, Words> words;
+    };
+
+    std::size_t _nb_vertices;
+    std::vector<std::size_t> _out_begin;
+    std::vector<std::uint32_t> _out_neighbors;
+    std::vector<bitset> _seen;
+    std::vector<bitset> _visit;
+    std::vector<bitset> _visit_next;
+    std::size_t _nb_sources;
+    std::array<std::uint64_t, max_nb_sources> _nb_reached;
+    std::array<std::uint64_t, max_nb_sources> _distance_sum;
+    std::uint32_t _nb_levels;
+
+public:
+    [[nodiscard]] explicit multi_source_bfs(const Graph & g)
+        : _nb_vertices(g.nb_vertices())
+        , _out_begin(g.nb_vertices() + 1, 0)
+        , _out_neighbors(g.nb_arcs())
+        , _seen(g.nb_vertices())
+        , _visit(g.nb_vertices())
+        , _visit_next(g.nb_vertices())
+        , _nb_sources(0)
+        , _nb_reached()
+        , _distance_sum()
+        , _nb_levels(0) {
+        for(auto && u : g.vertices()) {
+            _out_begin[u + 1] = _out_begin[u];
+            for(auto && a : g.out_arcs(u))
+                _out_neighbors[_out_begin[u + 1]++] =
+                    static_cast<std::uint32_t>(g.arc_target(a));
+        }
+    }
+
+    // number of vertices reached by the i-th source, itself included
+    [[nodiscard]] std::uint64_t nb_reached(const std::size_t i) const noexcept {
+        assert(i < _nb_sources);
+        return _nb_reached[i];
+    }
+    // sum of the distances from the i-th source to the vertices it reached
+    [[nodiscard]] std::uint64_t distance_sum(
+        const std::size_t i) const noexcept {
+        assert(i < _nb_sources);
+        return _distance_sum[i];
+    }
+    [[nodiscard]] std::uint32_t nb_levels() const noexcept {
+        return _nb_levels;
+    }
+
+    // Runs the searches from the given sources, stopped after max_level
+    // levels for k-hop reachability
+    void run(std::span<const vertex> sources,
+             const std::uint32_t max_level =
+                 std::numeric_limits<std::uint32_t>::max()) {
+        assert(sources.size() <= max_nb_sources);
+        _nb_sources = sources.size();
+        std::fill(_seen.begin(), _seen.end(), bitset{});
+        std::fill(_visit.begin(), _visit.end(), bitset{});
+        std::fill(_visit_next.begin(), _visit_next.end(), bitset{});
+        _nb_reached.fill(0);
+        _distance_sum.fill(0);
+        for(std::size_t i = 0; i < _nb_sources; ++i) {
+            set_bit(_seen[sources[i]], i);
+            set_bit(_visit[sources[i]], i);
+            _nb_reached[i] = 1;
+        }
+
+        for(_nb_levels = 0; _nb_levels < max_level;) {
+            for(std::size_t u = 0; u < _nb_vertices; ++u) {
+                const bitset & visit = _visit[u];
+                if(is_empty(visit)) continue;
+                for(std::size_t i = _out_begin[u]; i < _out_begin[u + 1]; ++i)
+                    or_into(_visit_next[_out_neighbors[i]], visit);
+            }
+            ++_nb_levels;
+            bool found = false;
+            for(std::size_t v = 0; v < _nb_vertices; ++v) {
+                bitset & next = _visit_next[v];
+                and_not(next, _seen[v]);
+                _visit[v] = bitset{};
+                if(is_empty(next)) continue;
+                found = true;
+                or_into(_seen[v], next);
+                count_new_bits(next);
+            }
+            if(!found) break;
+            std::swap(_visit, _visit_next);
+        }
+    }
+
+private:
+    static void set_bit(bitset & b, const std::size_t i) noexcept {
+        b.words[i / 64] |= std::uint64_t{1} << (i % 64);
+    }
+    [[nodiscard]] static bool is_empty(const bitset & b) noexcept {
+        std::uint64_t any = 0;
+        for(std::size_t w = 0; w < Words; ++w) any |= b.words[w];
+        return any == 0;
+    }
+    static void or_into(bitset & a, const bitset & b) noexcept {
+        for(std::size_t w = 0; w < Words; ++w) a.words[w] |= b.words[w];
+    }
+    static void and_not(bitset & a, const bitset & b) noexcept {
+        for(std::size_t w = 0; w < Words; ++w) a.words[w] &= ~b.words[w];
+    }
+    void count_new_bits(const bitset & b) noexcept {
+        for(std::size_t w = 0; w < Words; ++w) {
+            for(std::uint64_t bits = b.words[w]; bits != 0; bits &= bits - 1) {
+                const std::size_t i =
+                    w * 64 + static_cast<std::size_t>(std::countr_zero(bits));
+                ++_nb_reached[i];
+                _distance_sum[i] += _nb_levels;
+            }
+        }
+    }
+};
+
+#endif  // MULTI_SOURCE_BFS_HPP
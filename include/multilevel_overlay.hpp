@@ -0,0 +1,419 @@
+#ifndef MULTILEVEL_OVERLAY_HPP
+#define MULTILEVEL_OVERLAY_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "melon/container/d_ary_heap.hpp"
+#include "melon/container/static_digraph.hpp"
+
+#include "nested_partition.hpp"
+
+/**
+ * @brief Multilevel overlay of a digraph over a nested partition, for
+ * customizable route planning.
+ *
+ * The topology is fixed at construction: at each level, the boundary
+ * vertices of a cell are those with an arc to or from another cell of the
+ * level, and each cell gets a square matrix of lengths between its boundary
+ * vertices. customize() fills these cliques from a length map, level by
+ * level, the cells of a level being processed in parallel: the cliques of
+ * level 0 come from Dijkstra searches in the cell, those of the next levels
+ * from searches in the overlay of the level below restricted to the cell,
+ * i.e. its cliques and the arcs between its subcells. Changing the metric
+ * only requires a new customization.
+ */
+template <typename Graph, typename LengthMap>
+class multilevel_overlay {
+public:
+    using vertex = fhamonic::melon::vertex_t<Graph>;
+    using arc = fhamonic::melon::arc_t<Graph>;
+    using value_t = std::decay_t<decltype(std::declval<const LengthMap &>()[
+        std::declval<arc>()])>;
+
+    static constexpr value_t infinity = std::numeric_limits<value_t>::max();
+    static constexpr std::uint32_t no_index =
+        std::numeric_limits<std::uint32_t>::max();
+
+private:
+    struct level_overlay {
+        std::vector<std::size_t> boundary_begin;
+        std::vector<vertex> boundary;
+        std::vector<std::uint32_t> boundary_index_map;
+        std::vector<std::size_t> clique_begin;
+        std::vector<value_t> clique_lengths;
+    };
+    struct customization_workspace {
+        std::vector<value_t> dist_map;
+        std::vector<std::uint32_t> stamp_map;
+        std::uint32_t stamp = 0;
+        std::vector<std::pair<value_t, vertex>> queue;
+    };
+
+    std::reference_wrapper<const Graph> _graph;
+    std::reference_wrapper<const nested_partition> _partition;
+    std::vector<level_overlay> _levels;
+
+public:
+    [[nodiscard]] multilevel_overlay(const Graph & g,
+                                     const nested_partition & partition)
+        : _graph(std::cref(g))
+        , _partition(std::cref(partition))
+        , _levels(partition.nb_levels()) {
+        for(std::size_t k = 0; k < _levels.size(); ++k) {
+            level_overlay & level = _levels[k];
+            const auto & cell_map = partition.cell_map(k);
+            const std::size_t nb_cells = partition.nb_cells(k);
+            level.boundary_index_map.assign(g.nb_vertices(), no_index);
+            level.boundary_begin.assign(nb_cells + 1, 0);
+            for(auto && u : g.vertices()) {
+                const std::uint32_t c = cell_map[u];
+                bool is_boundary = false;
+                for(auto && a : g.out_arcs(u))
+                    is_boundary |= (cell_map[g.arc_target(a)] != c);
+                for(auto && a : g.in_arcs(u))
+                    is_boundary |= (cell_map[g.arc_source(a)] != c);
+                if(!is_boundary) continue;
+                level.boundary_index_map[u] = static_cast<std::uint32_t>(
+                    level.boundary_begin[c + 1]++);
+            }
+            for(std::size_t c = 0; c < nb_cells; ++c)
+                level.boundary_begin[c + 1] += level.boundary_begin[c];
+            level.boundary.resize(level.boundary_begin[nb_cells]);
+            for(auto && u : g.vertices()) {
+                if(level.boundary_index_map[u] == no_index) continue;
+                level.boundary[level.boundary_begin[cell_map[u]] +
+                               level.boundary_index_map[u]] = u;
+            }
+            level.clique_begin.assign(nb_cells + 1, 0);
+            for(std::size_t c = 0; c < nb_cells; ++c) {
+                const std::size_t b = nb_boundary_vertices(k, c);
+                level.clique_begin[c + 1] = level.clique_begin[c] + b * b;
+            }
+            level.clique_lengths.assign(level.clique_begin[nb_cells],
+                                        infinity);
+        }
+    }
+
+    [[nodiscard]] const Graph & graph() const noexcept { return _graph.get(); }
+    [[nodiscard]] const nested_partition & partition() const noexcept {
+        return _partition.get();
+    }
+    [[nodiscard]] std::size_t nb_levels() const noexcept {
+        return _levels.size();
+    }
+    [[nodiscard]] std::size_t nb_boundary_vertices(
+        const std::size_t level) const noexcept {
+        return _levels[level].boundary.size();
+    }
+    [[nodiscard]] std::size_t nb_boundary_vertices(
+        const std::size_t level, const std::size_t c) const noexcept {
+        return _levels[level].boundary_begin[c + 1] -
+               _levels[level].boundary_begin[c];
+    }
+    [[nodiscard]] std::size_t nb_clique_arcs() const noexcept {
+        std::size_t nb_arcs = 0;
+        for(auto && level : _levels) nb_arcs += level.clique_lengths.size();
+        return nb_arcs;
+    }
+    [[nodiscard]] std::uint32_t boundary_index(
+        const std::size_t level, const vertex u) const noexcept {
+        return _levels[level].boundary_index_map[u];
+    }
+    [[nodiscard]] vertex boundary_vertex(const std::size_t level,
+                                         const std::size_t c,
+                                         const std::size_t i) const noexcept {
+        return _levels[level].boundary[_levels[level].boundary_begin[c] + i];
+    }
+    // lengths from the i-th boundary vertex of the cell to the others
+    [[nodiscard]] const value_t * clique_row(
+        const std::size_t level, const std::size_t c,
+        const std::size_t i) const noexcept {
+        return _levels[level].clique_lengths.data() +
+               _levels[level].clique_begin[c] +
+               i * nb_boundary_vertices(level, c);
+    }
+    [[nodiscard]] value_t clique_length(const std::size_t level,
+                                        const std::size_t c,
+                                        const std::size_t i,
+                                        const std::size_t j) const noexcept {
+        return clique_row(level, c, i)[j];
+    }
+
+    void customize(const LengthMap & l, const std::size_t nb_threads) {
+        const std::size_t nb_workers = std::max(nb_threads, std::size_t{1});
+        std::vector<customization_workspace> workspaces(nb_workers);
+        for(std::size_t k = 0; k < _levels.size(); ++k) {
+            std::atomic<std::size_t> next_cell = 0;
+            auto work = [&](customization_workspace & ws) {
+                if(ws.dist_map.empty()) {
+                    ws.dist_map.resize(_graph.get().nb_vertices());
+                    ws.stamp_map.resize(_graph.get().nb_vertices(), 0);
+                }
+                const std::size_t nb_cells = _partition.get().nb_cells(k);
+                for(;;) {
+                    const std::size_t c =
+                        next_cell.fetch_add(1, std::memory_order_relaxed);
+                    if(c >= nb_cells) break;
+                    customize_cell(ws, l, k, c);
+                }
+            };
+            std::vector<std::thread> threads;
+            for(std::size_t t = 1; t < nb_workers; ++t)
+                threads.emplace_back(work, std::ref(workspaces[t]));
+            work(workspaces[0]);
+            for(auto & thread : threads) thread.join();
+        }
+    }
+
+private:
+    static void relax(customization_workspace & ws, const vertex w,
+                      const value_t new_dist) {
+        if(ws.stamp_map[w] == ws.stamp && ws.dist_map[w] <= new_dist) return;
+        ws.stamp_map[w] = ws.stamp;
+        ws.dist_map[w] = new_dist;
+        ws.queue.emplace_back(new_dist, w);
+        std::push_heap(ws.queue.begin(), ws.queue.end(), std::greater<>());
+    }
+
+    // Dijkstra from s restricted to the cell c of level k, on the original
+    // graph for k = 0 and on the overlay of level k-1 otherwise
+    void cell_search(customization_workspace & ws, const LengthMap & l,
+                     const std::size_t k, const std::uint32_t c,
+                     const vertex s) const {
+        const Graph & g = _graph.get();
+        const auto & cell_map = _partition.get().cell_map(k);
+        if(++ws.stamp == 0) {
+            std::fill(ws.stamp_map.begin(), ws.stamp_map.end(), 0);
+            ws.stamp = 1;
+        }
+        ws.queue.clear();
+        relax(ws, s, value_t{0});
+        while(!ws.queue.empty()) {
+            std::pop_heap(ws.queue.begin(), ws.queue.end(), std::greater<>());
+            const auto [x_dist, x] = ws.queue.back();
+            ws.queue.pop_back();
+            if(x_dist > ws.dist_map[x]) continue;
+            if(k == 0) {
+                for(auto && a : g.out_arcs(x)) {
+                    const vertex w = g.arc_target(a);
+                    if(cell_map[w] == c) relax(ws, w, x_dist + l[a]);
+                }
+                continue;
+            }
+            const auto & sub_cell_map = _partition.get().cell_map(k - 1);
+            const std::uint32_t x_cell = sub_cell_map[x];
+            const value_t * row =
+                clique_row(k - 1, x_cell, boundary_index(k - 1, x));
+            const std::size_t nb_sub_boundary =
+                nb_boundary_vertices(k - 1, x_cell);
+            for(std::size_t j = 0; j < nb_sub_boundary; ++j) {
+                if(row[j] == infinity) continue;
+                relax(ws, boundary_vertex(k - 1, x_cell, j), x_dist + row[j]);
+            }
+            for(auto && a : g.out_arcs(x)) {
+                const vertex w = g.arc_target(a);
+                if(cell_map[w] == c && sub_cell_map[w] != x_cell)
+                    relax(ws, w, x_dist + l[a]);
+            }
+        }
+    }
+
+    void customize_cell(customization_workspace & ws, const LengthMap & l,
+                        const std::size_t k, const std::size_t c) {
+        level_overlay & level = _levels[k];
+        const std::size_t nb_boundary = nb_boundary_vertices(k, c);
+        for(std::size_t i = 0; i < nb_boundary; ++i) {
+            cell_search(ws, l, k, static_cast<std::uint32_t>(c),
+                        boundary_vertex(k, c, i));
+            value_t * row = level.clique_lengths.data() +
+                            level.clique_begin[c] + i * nb_boundary;
+            for(std::size_t j = 0; j < nb_boundary; ++j) {
+                const vertex w = boundary_vertex(k, c, j);
+                row[j] = ws.stamp_map[w] == ws.stamp ? ws.dist_map[w]
+                                                     : infinity;
+            }
+        }
+    }
+};
+
+/**
+ * @brief Bidirectional point to point queries on a customized
+ * multilevel_overlay.
+ *
+ * A vertex is scanned at the highest level whose cell separates it from
+ * both the source and the target: in the original graph near the
+ * endpoints and through the cliques and the arcs leaving its cell
+ * elsewhere. The backward search reads the cliques transposed and the
+ * searches stop when the sum of their minimal keys exceeds the best meeting
+ * distance. The buffers are kept between queries.
+ */
+template <typename Graph, typename LengthMap>
+class multilevel_dijkstra {
+public:
+    using overlay = multilevel_overlay<Graph, LengthMap>;
+    using vertex = typename overlay::vertex;
+    using value_t = typename overlay::value_t;
+
+private:
+    enum vertex_status : char { PRE_HEAP = 0, IN_HEAP = 1, POST_HEAP = 2 };
+    using heap = fhamonic::melon::d_ary_heap<
+        4, vertex, value_t,
+        decltype([](const auto & e1, const auto & e2) {
+            return e1.second < e2.second;
+        }),
+        fhamonic::melon::vertex_map_t<Graph, std::size_t>>;
+    struct search {
+        heap queue;
+        std::vector<vertex_status> status_map;
+        std::vector<value_t> dist_map;
+        std::vector<vertex> touched;
+    };
+
+    std::reference_wrapper<const overlay> _overlay;
+    std::reference_wrapper<const LengthMap> _length_map;
+    search _searches[2];
+    vertex _source;
+    vertex _target;
+    value_t _best;
+    std::size_t _nb_scans;
+
+public:
+    [[nodiscard]] multilevel_dijkstra(const overlay & o, const LengthMap & l)
+        : _overlay(std::cref(o))
+        , _length_map(std::cref(l))
+        , _searches{{heap(fhamonic::melon::create_vertex_map<std::size_t>(
+                         o.graph())),
+                     std::vector<vertex_status>(o.graph().nb_vertices(),
+                                                PRE_HEAP),
+                     std::vector<value_t>(o.graph().nb_vertices()),
+                     {}},
+                    {heap(fhamonic::melon::create_vertex_map<std::size_t>(
+                         o.graph())),
+                     std::vector<vertex_status>(o.graph().nb_vertices(),
+                                                PRE_HEAP),
+                     std::vector<value_t>(o.graph().nb_vertices()),
+                     {}}}
+        , _source()
+        , _target()
+        , _best(overlay::infinity)
+        , _nb_scans(0) {}
+
+    [[nodiscard]] std::size_t nb_scans() const noexcept { return _nb_scans; }
+
+private:
+    // number of levels whose cell of u contains neither s nor t
+    [[nodiscard]] std::size_t query_level(const vertex u) const noexcept {
+        const nested_partition & partition = _overlay.get().partition();
+        std::size_t level = 0;
+        while(level < partition.nb_levels()) {
+            const auto & cell_map = partition.cell_map(level);
+            if(cell_map[u] == cell_map[_source] ||
+               cell_map[u] == cell_map[_target])
+                break;
+            ++level;
+        }
+        return level;
+    }
+
+    void relax(const std::size_t d, const vertex w, const value_t new_dist) {
+        search & s = _searches[d];
+        if(s.status_map[w] == IN_HEAP) {
+            if(new_dist >= s.dist_map[w]) return;
+            s.queue.promote(w, new_dist);
+        } else if(s.status_map[w] == PRE_HEAP) {
+            s.queue.push(w, new_dist);
+            s.status_map[w] = IN_HEAP;
+            s.touched.push_back(w);
+        } else {
+            return;
+        }
+        s.dist_map[w] = new_dist;
+        const search & other = _searches[1 - d];
+        if(other.status_map[w] != PRE_HEAP)
+            _best = std::min(_best, new_dist + other.dist_map[w]);
+    }
+
+    void scan(const std::size_t d) {
+        const overlay & o = _overlay.get();
+        const Graph & g = o.graph();
+        const LengthMap & l = _length_map.get();
+        search & s = _searches[d];
+        const auto [u, u_dist] = s.queue.top();
+        s.queue.pop();
+        s.status_map[u] = POST_HEAP;
+        ++_nb_scans;
+
+        const std::size_t level = query_level(u);
+        if(level == 0) {
+            if(d == 0) {
+                for(auto && a : g.out_arcs(u))
+                    relax(d, g.arc_target(a), u_dist + l[a]);
+            } else {
+                for(auto && a : g.in_arcs(u))
+                    relax(d, g.arc_source(a), u_dist + l[a]);
+            }
+            return;
+        }
+        const std::size_t k = level - 1;
+        const auto & cell_map = o.partition().cell_map(k);
+        const std::uint32_t c = cell_map[u];
+        const std::uint32_t i = o.boundary_index(k, u);
+        const std::size_t nb_boundary = o.nb_boundary_vertices(k, c);
+        if(d == 0) {
+            const value_t * row = o.clique_row(k, c, i);
+            for(std::size_t j = 0; j < nb_boundary; ++j) {
+                if(row[j] == overlay::infinity) continue;
+                relax(d, o.boundary_vertex(k, c, j), u_dist + row[j]);
+            }
+            for(auto && a : g.out_arcs(u)) {
+                const vertex w = g.arc_target(a);
+                if(cell_map[w] != c) relax(d, w, u_dist + l[a]);
+            }
+        } else {
+            for(std::size_t j = 0; j < nb_boundary; ++j) {
+                const value_t length = o.clique_length(k, c, j, i);
+                if(length == overlay::infinity) continue;
+                relax(d, o.boundary_vertex(k, c, j), u_dist + length);
+            }
+            for(auto && a : g.in_arcs(u)) {
+                const vertex w = g.arc_source(a);
+                if(cell_map[w] != c) relax(d, w, u_dist + l[a]);
+            }
+        }
+    }
+
+public:
+    // Returns the distance from s to t, or overlay::infinity
+    [[nodiscard]] value_t run(const vertex s, const vertex t) {
+        for(auto & searched : _searches) {
+            searched.queue.clear();
+            for(const vertex u : searched.touched)
+                searched.status_map[u] = PRE_HEAP;
+            searched.touched.clear();
+        }
+        _source = s;
+        _target = t;
+        _best = overlay::infinity;
+        _nb_scans = 0;
+        relax(0, s, value_t{0});
+        relax(1, t, value_t{0});
+        while(!_searches[0].queue.empty() && !_searches[1].queue.empty()) {
+            const value_t forward_min = _searches[0].queue.top().second;
+            const value_t backward_min = _searches[1].queue.top().second;
+            if(forward_min + backward_min >= _best) break;
+            scan(forward_min <= backward_min ? 0 : 1);
+        }
+        return _best;
+    }
+};
+
+#endif  // MULTILEVEL_OVERLAY_HPP
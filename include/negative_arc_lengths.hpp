@@ -0,0 +1,76 @@
+#ifndef NEGATIVE_ARC_LENGTHS_HPP
+#define NEGATIVE_ARC_LENGTHS_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <optional>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "melon/container/static_digraph.hpp"
+
+template <typename Value>
+struct potential_shifted_lengths {
+    std::vector<Value> potentials;
+    std::vector<Value> lengths;
+};
+
+/**
+ * Lengths with negative arcs but no negative cycle: each vertex gets a
+ * random integer potential p(u) in [0, max_potential] and each arc (u,v)
+ * the length l(u,v) + p(u) - p(v). The length of every cycle is unchanged,
+ * so that the shortest paths are the same and the distance from s to v is
+ * d(s,v) + p(s) - p(v) where d is the distance for l. Arcs become negative
+ * when the potential drop exceeds their length, so max_potential around a
+ * few times the average arc length gives a large ratio of negative arcs.
+ */
+template <typename Graph, typename LengthMap>
+auto generate_negative_arc_lengths(const Graph & g, const LengthMap & l,
+                                   const double max_potential,
+                                   const unsigned int seed = 1234) {
+    using arc = fhamonic::melon::arc_t<Graph>;
+    using value_t = std::decay_t<decltype(std::declval<const LengthMap &>()[
+        std::declval<arc>()])>;
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<long> potential_dist(
+        0, static_cast<long>(std::floor(max_potential)));
+    potential_shifted_lengths<value_t> result;
+    result.potentials.resize(g.nb_vertices());
+    for(auto && u : g.vertices())
+        result.potentials[u] = static_cast<value_t>(potential_dist(rng));
+    result.lengths.resize(g.nb_arcs());
+    for(auto && a : g.arcs())
+        result.lengths[a] = l[a] + result.potentials[g.arc_source(a)] -
+                            result.potentials[g.arc_target(a)];
+    return result;
+}
+
+/**
+ * Makes a random two arcs cycle negative by setting the length of one of
+ * its arcs to minus the length of the other minus one. Returns the modified
+ * arc, or nothing if the graph has no pair of opposite arcs.
+ */
+template <typename Graph, typename Value>
+std::optional<fhamonic::melon::arc_t<Graph>> insert_negative_cycle(
+    const Graph & g, std::vector<Value> & lengths,
+    const unsigned int seed = 1234) {
+    constexpr std::size_t max_nb_tries = 1000;
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<std::size_t> arc_dist(0, g.nb_arcs() - 1);
+    for(std::size_t i = 0; i < max_nb_tries && g.nb_arcs() > 0; ++i) {
+        const auto a = static_cast<fhamonic::melon::arc_t<Graph>>(
+            arc_dist(rng));
+        const auto u = g.arc_source(a);
+        for(auto && b : g.out_arcs(g.arc_target(a))) {
+            if(g.arc_target(b) != u) continue;
+            lengths[a] = -lengths[b] - Value{1};
+            return a;
+        }
+    }
+    return std::nullopt;
+}
+
+#endif  // NEGATIVE_ARC_LENGTHS_HPP
@@ -0,0 +1,156 @@
+#ifndef NESTED_PARTITION_HPP
+#define NESTED_PARTITION_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "melon/container/static_digraph.hpp"
+
+/**
+ * @brief Nested partition of the vertices of a digraph into cells of
+ * bounded sizes, one partition per level.
+ *
+ * The cells are computed by recursive bisection of the underlying
+ * undirected graph: a region is ordered by a breadth first search started
+ * from a pseudo peripheral vertex (the last vertex reached by a first
+ * search) and split in the middle of this order, which follows the BFS
+ * layers and thus cuts few arcs on road networks. A region becomes a cell
+ * of every level whose maximal cell size it fits, from the coarsest level
+ * down, so that each cell of a level is included in a cell of the next
+ * level. Level 0 is the finest.
+ */
+class nested_partition {
+private:
+    std::vector<std::size_t> _max_cell_sizes;
+    std::vector<std::size_t> _nb_cells;
+    std::vector<std::vector<std::uint32_t>> _cell_maps;
+
+    // bisection buffers
+    std::vector<std::size_t> _neighbors_begin;
+    std::vector<std::uint32_t> _neighbors;
+    std::vector<std::uint32_t> _order;
+    std::vector<std::uint32_t> _bfs_order;
+    std::vector<std::uint32_t> _region_map;
+    std::vector<std::uint32_t> _visited_map;
+    std::uint32_t _region;
+    std::uint32_t _visit;
+
+public:
+    template <typename Graph>
+    [[nodiscard]] nested_partition(const Graph & g,
+                                   std::vector<std::size_t> max_cell_sizes)
+        : _max_cell_sizes(std::move(max_cell_sizes))
+        , _nb_cells(_max_cell_sizes.size(), 0)
+        , _cell_maps(_max_cell_sizes.size(),
+                     std::vector<std::uint32_t>(g.nb_vertices()))
+        , _neighbors_begin(g.nb_vertices() + 1, 0)
+        , _order(g.nb_vertices())
+        , _region_map(g.nb_vertices(), 0)
+        , _visited_map(g.nb_vertices(), 0)
+        , _region(0)
+        , _visit(0) {
+        assert(std::is_sorted(_max_cell_sizes.begin(),
+                              _max_cell_sizes.end()));
+        for(auto && u : g.vertices()) {
+            _neighbors_begin[u + 1] = _neighbors_begin[u];
+            for(auto && a : g.out_arcs(u)) {
+                _neighbors.push_back(g.arc_target(a));
+                ++_neighbors_begin[u + 1];
+            }
+            for(auto && a : g.in_arcs(u)) {
+                _neighbors.push_back(g.arc_source(a));
+                ++_neighbors_begin[u + 1];
+            }
+        }
+        for(std::size_t i = 0; i < _order.size(); ++i)
+            _order[i] = static_cast<std::uint32_t>(i);
+        split(0, _order.size(), nb_levels());
+
+        _neighbors_begin = {};
+        _neighbors = {};
+        _order = {};
+        _bfs_order = {};
+        _region_map = {};
+        _visited_map = {};
+    }
+
+    [[nodiscard]] std::size_t nb_levels() const noexcept {
+        return _max_cell_sizes.size();
+    }
+    [[nodiscard]] std::size_t max_cell_size(
+        const std::size_t level) const noexcept {
+        return _max_cell_sizes[level];
+    }
+    [[nodiscard]] std::size_t nb_cells(const std::size_t level) const noexcept {
+        return _nb_cells[level];
+    }
+    [[nodiscard]] std::uint32_t cell(const std::size_t level,
+                                     const std::size_t u) const noexcept {
+        return _cell_maps[level][u];
+    }
+    [[nodiscard]] const std::vector<std::uint32_t> & cell_map(
+        const std::size_t level) const noexcept {
+        return _cell_maps[level];
+    }
+
+private:
+    // Appends to _bfs_order the vertices of the region reached from s
+    void bfs(const std::uint32_t s) {
+        std::size_t head = _bfs_order.size();
+        _visited_map[s] = _visit;
+        _bfs_order.push_back(s);
+        while(head < _bfs_order.size()) {
+            const std::uint32_t u = _bfs_order[head++];
+            for(std::size_t i = _neighbors_begin[u];
+                i < _neighbors_begin[u + 1]; ++i) {
+                const std::uint32_t w = _neighbors[i];
+                if(_region_map[w] != _region || _visited_map[w] == _visit)
+                    continue;
+                _visited_map[w] = _visit;
+                _bfs_order.push_back(w);
+            }
+        }
+    }
+
+    // Reorders _order[first, last) by a BFS of the region, started again
+    // from the remaining vertices when the region is not connected
+    void bfs_reorder(const std::size_t first, const std::size_t last) {
+        ++_region;
+        for(std::size_t i = first; i < last; ++i)
+            _region_map[_order[i]] = _region;
+        _bfs_order.clear();
+        ++_visit;
+        bfs(_order[first]);
+        const std::uint32_t peripheral = _bfs_order.back();
+        _bfs_order.clear();
+        ++_visit;
+        bfs(peripheral);
+        for(std::size_t i = first; i < last; ++i)
+            if(_visited_map[_order[i]] != _visit) bfs(_order[i]);
+        std::copy(_bfs_order.begin(), _bfs_order.end(),
+                  _order.begin() + static_cast<std::ptrdiff_t>(first));
+    }
+
+    // Assigns the cells of the levels below level to _order[first, last)
+    void split(const std::size_t first, const std::size_t last,
+               std::size_t level) {
+        while(level > 0 && last - first <= _max_cell_sizes[level - 1]) {
+            --level;
+            const std::uint32_t c =
+                static_cast<std::uint32_t>(_nb_cells[level]++);
+            for(std::size_t i = first; i < last; ++i)
+                _cell_maps[level][_order[i]] = c;
+        }
+        if(level == 0) return;
+        bfs_reorder(first, last);
+        const std::size_t middle = first + (last - first) / 2;
+        split(first, middle, level);
+        split(middle, last, level);
+    }
+};
+
+#endif  // NESTED_PARTITION_HPP
@@ -0,0 +1,344 @@
+#ifndef PAGE_RANK_HPP
+#define PAGE_RANK_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include "melon/container/static_digraph.hpp"
+
+enum class page_rank_kernel : char {
+    pull,  // gathers the contributions of the in neighbors
+    push,  // scatters the contributions to the out neighbors
+    propagation_blocking  // scatters the contributions into bins first
+};
+
+/**
+ * @brief PageRank by power iterations over CSR copies of the graph.
+ *
+ * An iteration computes the contribution rank(u) / out_degree(u) of every
+ * vertex, the rank of the dangling vertices being spread uniformly, then
+ * sets rank(v) = (1 - d) / n + d * (dangling / n + sum of the contributions
+ * of the in neighbors of v) with the kernel given as template parameter:
+ * - pull reads the in neighbors from a transpose CSR, without write
+ *   conflicts;
+ * - push adds the contributions of each vertex to its out neighbors, with
+ *   atomic additions when several threads run;
+ * - propagation_blocking (Beamer et al.) splits the vertices into blocks
+ *   whose accumulators fit in cache. Each thread appends the contributions
+ *   of its vertices sequentially into per block bins, whose destinations
+ *   are computed once at construction. Then each block sums its bins.
+ * The threads own slices of vertices balanced by numbers of arcs and
+ * synchronize on barriers, whose completion steps reduce the dangling rank
+ * and the L1 distance between successive rank vectors.
+ */
+template <typename Graph, page_rank_kernel Kernel = page_rank_kernel::pull>
+class page_rank {
+public:
+    using vertex = fhamonic::melon::vertex_t<Graph>;
+
+private:
+    static constexpr bool use_in_arcs = Kernel == page_rank_kernel::pull;
+    static constexpr bool use_bins =
+        Kernel == page_rank_kernel::propagation_blocking;
+    // 256KB of accumulators
+    static constexpr std::size_t block_size = std::size_t{1} << 15;
+
+    struct alignas(64) thread_sums {
+        double dangling;
+        double l1_delta;
+    };
+
+    std::size_t _nb_vertices;
+    std::size_t _nb_arcs;
+    std::size_t _nb_threads;
+    double _damping;
+    std::vector<std::size_t> _out_begin;
+    std::vector<std::uint32_t> _out_neighbors;  // empty for pull
+    std::vector<std::size_t> _in_begin;         // pull only
+    std::vector<std::uint32_t> _in_neighbors;   // pull only
+    std::size_t _nb_blocks;
+    std::vector<std::size_t> _bin_begin;  // by block, then by thread
+    std::vector<std::uint32_t> _bin_targets;
+    std::vector<double> _bin_values;
+    std::vector<std::size_t> _bin_cursors;  // by thread, then by block
+    std::vector<std::size_t> _slice_begin;
+
+    std::vector<double> _rank_map;
+    std::vector<double> _next_rank_map;  // also the push accumulators
+    std::vector<double> _contribution_map;
+    std::vector<thread_sums> _thread_sums;
+    std::atomic<std::size_t> _next_block;
+    double _base_rank;
+    double _l1_delta;
+    std::size_t _nb_iterations;
+
+public:
+    [[nodiscard]] page_rank(const Graph & g, const double damping = 0.85,
+                            const std::size_t nb_threads = 1)
+        : _nb_vertices(g.nb_vertices())
+        , _nb_arcs(g.nb_arcs())
+        , _nb_threads(std::max(nb_threads, std::size_t{1}))
+        , _damping(damping)
+        , _out_begin(g.nb_vertices() + 1, 0)
+        , _nb_blocks((g.nb_vertices() + block_size - 1) / block_size)
+        , _rank_map(g.nb_vertices())
+        , _next_rank_map(g.nb_vertices())
+        , _contribution_map(g.nb_vertices())
+        , _thread_sums(_nb_threads)
+        , _next_block(0)
+        , _base_rank(0.0)
+        , _l1_delta(0.0)
+        , _nb_iterations(0) {
+        std::vector<std::uint32_t> out_neighbors(g.nb_arcs());
+        for(auto && u : g.vertices()) {
+            _out_begin[u + 1] = _out_begin[u];
+            for(auto && a : g.out_arcs(u))
+                out_neighbors[_out_begin[u + 1]++] =
+                    static_cast<std::uint32_t>(g.arc_target(a));
+        }
+        if constexpr(use_in_arcs) {
+            build_in_arcs(out_neighbors);
+            compute_slices(_in_begin);
+        } else {
+            _out_neighbors = std::move(out_neighbors);
+            compute_slices(_out_begin);
+        }
+        if constexpr(use_bins) build_bins();
+    }
+
+    [[nodiscard]] std::size_t nb_threads() const noexcept {
+        return _nb_threads;
+    }
+    [[nodiscard]] double rank(const vertex u) const noexcept {
+        return _rank_map[u];
+    }
+    [[nodiscard]] std::size_t nb_iterations() const noexcept {
+        return _nb_iterations;
+    }
+    // L1 distance between the rank vectors of the last two iterations
+    [[nodiscard]] double l1_delta() const noexcept { return _l1_delta; }
+    // Bytes that an iteration reads and writes at least, whatever the
+    // kernel: the offsets and neighbors of one CSR and the rank vectors
+    [[nodiscard]] std::size_t bytes_per_iteration() const noexcept {
+        return _nb_vertices * (sizeof(std::size_t) + 3 * sizeof(double)) +
+               _nb_arcs * sizeof(std::uint32_t);
+    }
+
+    // Iterates from the uniform vector until the L1 distance between
+    // successive rank vectors falls below tolerance, a tolerance of 0
+    // running exactly max_iterations iterations
+    void run(const double tolerance = 1e-6,
+             const std::size_t max_iterations = 100) {
+        _nb_iterations = 0;
+        _l1_delta = std::numeric_limits<double>::infinity();
+        if(_nb_vertices == 0) return;
+        std::fill(_rank_map.begin(), _rank_map.end(),
+                  1.0 / static_cast<double>(_nb_vertices));
+        if(max_iterations == 0) return;
+
+        bool finished = false;
+        std::barrier sync_contributions(
+            static_cast<std::ptrdiff_t>(_nb_threads),
+            [this]() noexcept { on_contributions_end(); });
+        std::barrier sync_scatter(static_cast<std::ptrdiff_t>(_nb_threads));
+        std::barrier sync_iteration(
+            static_cast<std::ptrdiff_t>(_nb_threads), [&]() noexcept {
+                on_iteration_end();
+                finished =
+                    _l1_delta < tolerance || _nb_iterations >= max_iterations;
+            });
+        auto work = [&](const std::size_t t) {
+            const std::size_t first = _slice_begin[t];
+            const std::size_t last = _slice_begin[t + 1];
+            for(;;) {
+                compute_contributions(t, first, last);
+                sync_contributions.arrive_and_wait();
+                if constexpr(Kernel == page_rank_kernel::pull) {
+                    pull(t, first, last);
+                } else if constexpr(Kernel == page_rank_kernel::push) {
+                    push(first, last);
+                    sync_scatter.arrive_and_wait();
+                    finish_ranks(t, first, last);
+                } else {
+                    fill_bins(t, first, last);
+                    sync_scatter.arrive_and_wait();
+                    accumulate_bins(t);
+                }
+                sync_iteration.arrive_and_wait();
+                if(finished) break;
+            }
+        };
+        std::vector<std::thread> threads;
+        for(std::size_t t = 1; t < _nb_threads; ++t)
+            threads.emplace_back(work, t);
+        work(0);
+        for(auto & thread : threads) thread.join();
+    }
+
+private:
+    void build_in_arcs(const std::vector<std::uint32_t> & out_neighbors) {
+        _in_begin.assign(_nb_vertices + 1, 0);
+        _in_neighbors.resize(_nb_arcs);
+        for(const std::uint32_t v : out_neighbors) ++_in_begin[v + 1];
+        for(std::size_t v = 0; v < _nb_vertices; ++v)
+            _in_begin[v + 1] += _in_begin[v];
+        std::vector<std::size_t> in_position(_in_begin.begin(),
+                                             _in_begin.end() - 1);
+        for(std::size_t u = 0; u < _nb_vertices; ++u)
+            for(std::size_t i = _out_begin[u]; i < _out_begin[u + 1]; ++i)
+                _in_neighbors[in_position[out_neighbors[i]]++] =
+                    static_cast<std::uint32_t>(u);
+    }
+    // slices of contiguous vertices of about equal numbers of vertices plus
+    // arcs of the given CSR
+    void compute_slices(const std::vector<std::size_t> & begin) {
+        _slice_begin.assign(_nb_threads + 1, _nb_vertices);
+        _slice_begin[0] = 0;
+        const std::size_t total = _nb_vertices + _nb_arcs;
+        std::size_t u = 0;
+        for(std::size_t t = 1; t < _nb_threads; ++t) {
+            const std::size_t target = total / _nb_threads * t;
+            while(u < _nb_vertices && u + begin[u] < target) ++u;
+            _slice_begin[t] = u;
+        }
+    }
+    void build_bins() {
+        _bin_begin.assign(_nb_blocks * _nb_threads + 1, 0);
+        for(std::size_t t = 0; t < _nb_threads; ++t)
+            for(std::size_t u = _slice_begin[t]; u < _slice_begin[t + 1]; ++u)
+                for(std::size_t i = _out_begin[u]; i < _out_begin[u + 1]; ++i)
+                    ++_bin_begin[_out_neighbors[i] / block_size * _nb_threads +
+                                 t + 1];
+        for(std::size_t i = 0; i + 1 < _bin_begin.size(); ++i)
+            _bin_begin[i + 1] += _bin_begin[i];
+        _bin_targets.resize(_nb_arcs);
+        _bin_values.resize(_nb_arcs);
+        _bin_cursors.resize(_nb_threads * _nb_blocks);
+        for(std::size_t t = 0; t < _nb_threads; ++t) {
+            std::size_t * const cursors = reset_bin_cursors(t);
+            for(std::size_t u = _slice_begin[t]; u < _slice_begin[t + 1]; ++u)
+                for(std::size_t i = _out_begin[u]; i < _out_begin[u + 1]; ++i)
+                    _bin_targets[cursors[_out_neighbors[i] / block_size]++] =
+                        _out_neighbors[i];
+        }
+    }
+    std::size_t * reset_bin_cursors(const std::size_t t) noexcept {
+        std::size_t * const cursors = _bin_cursors.data() + t * _nb_blocks;
+        for(std::size_t b = 0; b < _nb_blocks; ++b)
+            cursors[b] = _bin_begin[b * _nb_threads + t];
+        return cursors;
+    }
+
+    void compute_contributions(const std::size_t t, const std::size_t first,
+                               const std::size_t last) noexcept {
+        double dangling = 0.0;
+        for(std::size_t u = first; u < last; ++u) {
+            const std::size_t degree = _out_begin[u + 1] - _out_begin[u];
+            if(degree == 0) {
+                dangling += _rank_map[u];
+                _contribution_map[u] = 0.0;
+            } else {
+                _contribution_map[u] =
+                    _rank_map[u] / static_cast<double>(degree);
+            }
+            if constexpr(Kernel == page_rank_kernel::push)
+                _next_rank_map[u] = 0.0;
+        }
+        _thread_sums[t].dangling = dangling;
+    }
+
+    void pull(const std::size_t t, const std::size_t first,
+              const std::size_t last) noexcept {
+        double l1_delta = 0.0;
+        for(std::size_t v = first; v < last; ++v) {
+            double sum = 0.0;
+            for(std::size_t i = _in_begin[v]; i < _in_begin[v + 1]; ++i)
+                sum += _contribution_map[_in_neighbors[i]];
+            _next_rank_map[v] = _base_rank + _damping * sum;
+            l1_delta += std::abs(_next_rank_map[v] - _rank_map[v]);
+        }
+        _thread_sums[t].l1_delta = l1_delta;
+    }
+
+    void push(const std::size_t first, const std::size_t last) noexcept {
+        for(std::size_t u = first; u < last; ++u) {
+            const double contribution = _contribution_map[u];
+            for(std::size_t i = _out_begin[u]; i < _out_begin[u + 1]; ++i) {
+                double & sum = _next_rank_map[_out_neighbors[i]];
+                if(_nb_threads == 1)
+                    sum += contribution;
+                else
+                    std::atomic_ref<double>(sum).fetch_add(
+                        contribution, std::memory_order_relaxed);
+            }
+        }
+    }
+    void finish_ranks(const std::size_t t, const std::size_t first,
+                      const std::size_t last) noexcept {
+        double l1_delta = 0.0;
+        for(std::size_t v = first; v < last; ++v) {
+            _next_rank_map[v] = _base_rank + _damping * _next_rank_map[v];
+            l1_delta += std::abs(_next_rank_map[v] - _rank_map[v]);
+        }
+        _thread_sums[t].l1_delta = l1_delta;
+    }
+
+    void fill_bins(const std::size_t t, const std::size_t first,
+                   const std::size_t last) noexcept {
+        std::size_t * const cursors = reset_bin_cursors(t);
+        for(std::size_t u = first; u < last; ++u) {
+            const double contribution = _contribution_map[u];
+            for(std::size_t i = _out_begin[u]; i < _out_begin[u + 1]; ++i)
+                _bin_values[cursors[_out_neighbors[i] / block_size]++] =
+                    contribution;
+        }
+    }
+    // the blocks are taken from an atomic counter
+    void accumulate_bins(const std::size_t t) noexcept {
+        double l1_delta = 0.0;
+        for(;;) {
+            const std::size_t b =
+                _next_block.fetch_add(1, std::memory_order_relaxed);
+            if(b >= _nb_blocks) break;
+            const std::size_t first = b * block_size;
+            const std::size_t last = std::min(_nb_vertices, first + block_size);
+            std::fill(
+                _next_rank_map.begin() + static_cast<std::ptrdiff_t>(first),
+                _next_rank_map.begin() + static_cast<std::ptrdiff_t>(last),
+                0.0);
+            for(std::size_t i = _bin_begin[b * _nb_threads];
+                i < _bin_begin[(b + 1) * _nb_threads]; ++i)
+                _next_rank_map[_bin_targets[i]] += _bin_values[i];
+            for(std::size_t v = first; v < last; ++v) {
+                _next_rank_map[v] = _base_rank + _damping * _next_rank_map[v];
+                l1_delta += std::abs(_next_rank_map[v] - _rank_map[v]);
+            }
+        }
+        _thread_sums[t].l1_delta = l1_delta;
+    }
+
+    // barrier completion steps, run by a single thread
+    void on_contributions_end() noexcept {
+        double dangling = 0.0;
+        for(const thread_sums & sums : _thread_sums) dangling += sums.dangling;
+        const double n = static_cast<double>(_nb_vertices);
+        _base_rank = (1.0 - _damping) / n + _damping * dangling / n;
+        _next_block.store(0, std::memory_order_relaxed);
+    }
+    void on_iteration_end() noexcept {
+        _l1_delta = 0.0;
+        for(const thread_sums & sums : _thread_sums) _l1_delta += sums.l1_delta;
+        std::swap(_rank_map, _next_rank_map);
+        ++_nb_iterations;
+    }
+};
+
+#endif  // PAGE_RANK_HPP
@@ -0,0 +1,158 @@
+#ifndef PAIRING_HEAP_HPP
+#define PAIRING_HEAP_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Pairing heap with decrease-key, following the interface of melon's
+ * d_ary_heap.
+ *
+ * Nodes live in a pool whose freed slots are recycled, and the indices map
+ * stores the slot of each id in the heap. Children are kept in a doubly
+ * linked sibling list so that a promoted node is cut in constant time, and
+ * pop() melds the children of the root with the two-pass scheme.
+ */
+template <typename ID, typename PRIO, typename PRIO_COMPARE = std::less<PRIO>,
+          typename IndicesMap = std::vector<std::size_t>>
+class pairing_heap {
+public:
+    using id_type = ID;
+    using priority_type = PRIO;
+    using entry = std::pair<id_type, priority_type>;
+    using indices_map = IndicesMap;
+
+private:
+    static constexpr std::size_t null_node =
+        std::numeric_limits<std::size_t>::max();
+
+    struct node {
+        entry value;
+        std::size_t child;
+        std::size_t next;
+        // previous sibling, or parent for the first child
+        std::size_t prev;
+    };
+
+    std::vector<node> _nodes;
+    std::vector<std::size_t> _free_nodes;
+    std::vector<std::size_t> _pairs;
+    IndicesMap _indices_map;
+    [[no_unique_address]] PRIO_COMPARE _cmp;
+    std::size_t _root;
+    std::size_t _size;
+
+public:
+    [[nodiscard]] constexpr explicit pairing_heap(
+        IndicesMap && indices, PRIO_COMPARE && cmp = PRIO_COMPARE())
+        : _nodes()
+        , _free_nodes()
+        , _pairs()
+        , _indices_map(std::move(indices))
+        , _cmp(std::move(cmp))
+        , _root(null_node)
+        , _size(0) {}
+
+    constexpr pairing_heap(const pairing_heap &) = default;
+    constexpr pairing_heap(pairing_heap &&) = default;
+    constexpr pairing_heap & operator=(const pairing_heap &) = default;
+    constexpr pairing_heap & operator=(pairing_heap &&) = default;
+
+    [[nodiscard]] constexpr std::size_t size() const noexcept { return _size; }
+    [[nodiscard]] constexpr bool empty() const noexcept { return _size == 0; }
+    constexpr void clear() noexcept {
+        _nodes.clear();
+        _free_nodes.clear();
+        _root = null_node;
+        _size = 0;
+    }
+
+private:
+    // Links two roots and returns the new root
+    [[nodiscard]] constexpr std::size_t link(const std::size_t a,
+                                             const std::size_t b) noexcept {
+        if(b == null_node) return a;
+        if(a == null_node) return b;
+        const bool a_first =
+            !_cmp(_nodes[b].value.second, _nodes[a].value.second);
+        const std::size_t parent = a_first ? a : b;
+        const std::size_t child = a_first ? b : a;
+        node & p = _nodes[parent];
+        node & c = _nodes[child];
+        c.next = p.child;
+        c.prev = parent;
+        if(p.child != null_node) _nodes[p.child].prev = child;
+        p.child = child;
+        p.next = p.prev = null_node;
+        return parent;
+    }
+    constexpr void cut(const std::size_t n) noexcept {
+        node & x = _nodes[n];
+        if(_nodes[x.prev].child == n)
+            _nodes[x.prev].child = x.next;
+        else
+            _nodes[x.prev].next = x.next;
+        if(x.next != null_node) _nodes[x.next].prev = x.prev;
+        x.next = x.prev = null_node;
+    }
+    [[nodiscard]] constexpr std::size_t two_pass_merge(std::size_t first) {
+        _pairs.clear();
+        while(first != null_node) {
+            const std::size_t a = first;
+            const std::size_t b = _nodes[a].next;
+            first = (b == null_node) ? null_node : _nodes[b].next;
+            _nodes[a].next = _nodes[a].prev = null_node;
+            if(b != null_node) _nodes[b].next = _nodes[b].prev = null_node;
+            _pairs.push_back(link(a, b));
+        }
+        std::size_t root = null_node;
+        for(auto it = _pairs.rbegin(); it != _pairs.rend(); ++it)
+            root = link(*it, root);
+        return root;
+    }
+
+public:
+    constexpr void push(const id_type & id, const priority_type & p) {
+        std::size_t n;
+        if(_free_nodes.empty()) {
+            n = _nodes.size();
+            _nodes.push_back({entry(id, p), null_node, null_node, null_node});
+        } else {
+            n = _free_nodes.back();
+            _free_nodes.pop_back();
+            _nodes[n] = {entry(id, p), null_node, null_node, null_node};
+        }
+        _indices_map[id] = n;
+        _root = link(_root, n);
+        ++_size;
+    }
+    [[nodiscard]] constexpr const priority_type & priority(
+        const id_type & id) const noexcept {
+        return _nodes[_indices_map[id]].value.second;
+    }
+    constexpr void promote(const id_type & id,
+                           const priority_type & p) noexcept {
+        const std::size_t n = _indices_map[id];
+        _nodes[n].value.second = p;
+        if(n == _root) return;
+        cut(n);
+        _root = link(_root, n);
+    }
+    [[nodiscard]] constexpr entry top() const noexcept {
+        assert(!empty());
+        return _nodes[_root].value;
+    }
+    constexpr void pop() {
+        assert(!empty());
+        const std::size_t old_root = _root;
+        _root = two_pass_merge(_nodes[old_root].child);
+        _free_nodes.push_back(old_root);
+        --_size;
+    }
+};
+
+#endif  // PAIRING_HEAP_HPP
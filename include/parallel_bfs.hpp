@@ -0,0 +1,245 @@
+#ifndef PARALLEL_BFS_HPP
+#define PARALLEL_BFS_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include "melon/container/static_digraph.hpp"
+
+/**
+ * @brief Parallel level synchronous breadth first search.
+ *
+ * The out adjacency is copied in a CSR. At each level, the arcs of the
+ * frontier, seen as one concatenated range, are cut into chunks of equal
+ * numbers of arcs that the threads take from an atomic counter, so that the
+ * adjacency of a hub is shared among threads. A vertex is visited by the
+ * thread whose compare-and-swap of its level succeeds, which appends it to
+ * its local next frontier; the local frontiers are then copied side by side
+ * into the shared frontier. The worker threads are created with the engine
+ * and park on a barrier between searches, so that a search only pays for
+ * its synchronizations; they synchronize on barriers whose completion steps
+ * compute the offsets and the chunks.
+ */
+template <typename Graph>
+class parallel_bfs {
+public:
+    using vertex = fhamonic::melon::vertex_t<Graph>;
+    static constexpr std::uint32_t unreached =
+        std::numeric_limits<std::uint32_t>::max();
+
+private:
+    static constexpr std::size_t min_chunk_arcs = 1024;
+    static constexpr std::size_t chunks_per_thread = 8;
+
+    // barrier completion steps, run by a single thread
+    struct start_step {
+        parallel_bfs * bfs;
+        void operator()() noexcept { bfs->on_search_start(); }
+    };
+    struct level_end_step {
+        parallel_bfs * bfs;
+        void operator()() noexcept { bfs->on_level_end(); }
+    };
+    struct copy_end_step {
+        parallel_bfs * bfs;
+        void operator()() noexcept { bfs->prepare_chunks(); }
+    };
+    struct reset_end_step {
+        parallel_bfs * bfs;
+        void operator()() noexcept { bfs->_level_map[bfs->_source] = 0; }
+    };
+
+    std::size_t _nb_vertices;
+    std::size_t _nb_threads;
+    std::vector<std::size_t> _out_begin;
+    std::vector<std::uint32_t> _out_neighbors;
+
+    std::vector<std::uint32_t> _level_map;
+    std::vector<std::uint32_t> _frontier;
+    std::vector<std::size_t> _frontier_arcs_begin;  // prefix of out degrees
+    std::vector<std::vector<std::uint32_t>> _local_frontiers;
+    std::vector<std::size_t> _local_offsets;
+    std::atomic<std::size_t> _next_chunk;
+    std::size_t _chunk_arcs;
+    std::size_t _nb_chunks;
+    std::uint32_t _level;
+    bool _finished;
+    std::uint32_t _source;
+    bool _stop;
+
+    std::barrier<start_step> _sync_start;
+    std::barrier<level_end_step> _sync;
+    std::barrier<copy_end_step> _sync_copy;
+    std::barrier<reset_end_step> _sync_reset;
+    std::vector<std::thread> _workers;
+
+public:
+    [[nodiscard]] parallel_bfs(const Graph & g, const std::size_t nb_threads)
+        : _nb_vertices(g.nb_vertices())
+        , _nb_threads(std::max(nb_threads, std::size_t{1}))
+        , _out_begin(g.nb_vertices() + 1, 0)
+        , _out_neighbors(g.nb_arcs())
+        , _level_map(g.nb_vertices(), unreached)
+        , _local_frontiers(_nb_threads)
+        , _local_offsets(_nb_threads + 1)
+        , _next_chunk(0)
+        , _chunk_arcs(0)
+        , _nb_chunks(0)
+        , _level(0)
+        , _finished(false)
+        , _source(0)
+        , _stop(false)
+        , _sync_start(static_cast<std::ptrdiff_t>(_nb_threads),
+                      start_step{this})
+        , _sync(static_cast<std::ptrdiff_t>(_nb_threads), level_end_step{this})
+        , _sync_copy(static_cast<std::ptrdiff_t>(_nb_threads),
+                     copy_end_step{this})
+        , _sync_reset(static_cast<std::ptrdiff_t>(_nb_threads),
+                      reset_end_step{this}) {
+        for(auto && u : g.vertices()) {
+            _out_begin[u + 1] = _out_begin[u];
+            for(auto && a : g.out_arcs(u))
+                _out_neighbors[_out_begin[u + 1]++] =
+                    static_cast<std::uint32_t>(g.arc_target(a));
+        }
+        // a frontier holds each vertex at most once, so that the barrier
+        // completion steps never reallocate
+        _frontier.reserve(_nb_vertices);
+        _frontier_arcs_begin.reserve(_nb_vertices + 1);
+        for(std::size_t t = 1; t < _nb_threads; ++t)
+            _workers.emplace_back([this, t]() {
+                for(;;) {
+                    _sync_start.arrive_and_wait();
+                    if(_stop) break;
+                    search(t);
+                }
+            });
+    }
+    parallel_bfs(const parallel_bfs &) = delete;
+    parallel_bfs & operator=(const parallel_bfs &) = delete;
+    ~parallel_bfs() {
+        _stop = true;
+        _sync_start.arrive_and_wait();
+        for(auto & worker : _workers) worker.join();
+    }
+
+    [[nodiscard]] std::size_t nb_threads() const noexcept {
+        return _nb_threads;
+    }
+    [[nodiscard]] bool reached(const vertex u) const noexcept {
+        return _level_map[u] != unreached;
+    }
+    [[nodiscard]] std::uint32_t level(const vertex u) const noexcept {
+        assert(reached(u));
+        return _level_map[u];
+    }
+
+    void run(const vertex s) {
+        _source = static_cast<std::uint32_t>(s);
+        _sync_start.arrive_and_wait();
+        search(0);
+    }
+
+private:
+    void search(const std::size_t t) {
+        // the level map is reset by slices before the search
+        const std::size_t slice =
+            (_nb_vertices + _nb_threads - 1) / _nb_threads;
+        const std::size_t first = std::min(_nb_vertices, t * slice);
+        const std::size_t last = std::min(_nb_vertices, first + slice);
+        std::fill(_level_map.begin() + static_cast<std::ptrdiff_t>(first),
+                  _level_map.begin() + static_cast<std::ptrdiff_t>(last),
+                  unreached);
+        _sync_reset.arrive_and_wait();
+        for(;;) {
+            explore_chunks(_local_frontiers[t]);
+            _sync.arrive_and_wait();
+            if(_finished) break;
+            std::copy(_local_frontiers[t].begin(), _local_frontiers[t].end(),
+                      _frontier.begin() +
+                          static_cast<std::ptrdiff_t>(_local_offsets[t]));
+            _local_frontiers[t].clear();
+            _sync_copy.arrive_and_wait();
+        }
+    }
+
+    void explore_chunks(std::vector<std::uint32_t> & next) {
+        const std::uint32_t next_level = _level + 1;
+        for(;;) {
+            const std::size_t c =
+                _next_chunk.fetch_add(1, std::memory_order_relaxed);
+            if(c >= _nb_chunks) break;
+            std::size_t arc_index = c * _chunk_arcs;
+            const std::size_t arc_end = std::min(
+                arc_index + _chunk_arcs, _frontier_arcs_begin.back());
+            // frontier vertex whose arcs contain arc_index
+            std::size_t i = static_cast<std::size_t>(
+                std::upper_bound(_frontier_arcs_begin.begin(),
+                                 _frontier_arcs_begin.end(), arc_index) -
+                _frontier_arcs_begin.begin() - 1);
+            while(arc_index < arc_end) {
+                const std::uint32_t u = _frontier[i];
+                const std::size_t offset = arc_index - _frontier_arcs_begin[i];
+                const std::size_t nb_arcs =
+                    std::min(_frontier_arcs_begin[i + 1], arc_end) - arc_index;
+                const std::uint32_t * const neighbors =
+                    _out_neighbors.data() + _out_begin[u] + offset;
+                for(std::size_t j = 0; j < nb_arcs; ++j)
+                    visit(neighbors[j], next_level, next);
+                arc_index += nb_arcs;
+                ++i;
+            }
+        }
+    }
+    void visit(const std::uint32_t v, const std::uint32_t next_level,
+               std::vector<std::uint32_t> & next) {
+        std::atomic_ref<std::uint32_t> level(_level_map[v]);
+        std::uint32_t expected = level.load(std::memory_order_relaxed);
+        if(expected != unreached) return;
+        if(level.compare_exchange_strong(expected, next_level,
+                                         std::memory_order_relaxed))
+            next.push_back(v);
+    }
+
+    // barrier completion steps, whose resizes stay within the reserved
+    // capacities. The search state is only initialized once every thread
+    // left the previous search.
+    void on_search_start() noexcept {
+        if(_stop) return;
+        _frontier.assign(1, _source);
+        _level = 0;
+        _finished = false;
+        prepare_chunks();
+    }
+    void on_level_end() noexcept {
+        _local_offsets[0] = 0;
+        for(std::size_t t = 0; t < _nb_threads; ++t)
+            _local_offsets[t + 1] =
+                _local_offsets[t] + _local_frontiers[t].size();
+        _finished = _local_offsets[_nb_threads] == 0;
+        _frontier.resize(_local_offsets[_nb_threads]);
+        ++_level;
+    }
+    void prepare_chunks() noexcept {
+        _frontier_arcs_begin.resize(_frontier.size() + 1);
+        _frontier_arcs_begin[0] = 0;
+        for(std::size_t i = 0; i < _frontier.size(); ++i)
+            _frontier_arcs_begin[i + 1] =
+                _frontier_arcs_begin[i] + _out_begin[_frontier[i] + 1] -
+                _out_begin[_frontier[i]];
+        const std::size_t nb_arcs = _frontier_arcs_begin.back();
+        _chunk_arcs = std::max(min_chunk_arcs,
+                               nb_arcs / (_nb_threads * chunks_per_thread));
+        _nb_chunks = (nb_arcs + _chunk_arcs - 1) / _chunk_arcs;
+        _next_chunk.store(0, std::memory_order_relaxed);
+    }
+};
+
+#endif  // PARALLEL_BFS_HPP
@@ -0,0 +1,177 @@
+#ifndef PHAST_HPP
+#define PHAST_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "melon/container/d_ary_heap.hpp"
+#include "melon/container/static_digraph.hpp"
+
+#include "contraction_hierarchy.hpp"
+
+/**
+ * @brief PHAST one-to-all shortest paths on a contraction hierarchy.
+ *
+ * The vertices are renumbered by decreasing rank and the hierarchy is copied
+ * in two arrays in this order: the upward arcs of each vertex and the
+ * downward in-arcs of each vertex. A query runs a Dijkstra from the source
+ * on the upward arcs, then sweeps the vertices in increasing new id, i.e.
+ * decreasing rank, relaxing their downward in-arcs, whose sources are
+ * already final. The sweep reads the arcs and writes the distances
+ * linearly. With K > 1, K sources are processed at once: each vertex holds
+ * K distances in a block aligned on its size, as in batched_dijkstra, and
+ * the sweep relaxes all the lanes of an arc with a fixed length loop that
+ * compiles to SIMD instructions (with OPTIMIZE_FOR_NATIVE).
+ */
+template <typename Graph, typename LengthMap, std::size_t K = 1>
+class phast {
+public:
+    using vertex = fhamonic::melon::vertex_t<Graph>;
+    using hierarchy = contraction_hierarchy<Graph, LengthMap>;
+    using value_t = typename hierarchy::value_t;
+    struct alignas(K * sizeof(value_t)) lanes {
+        value_t lane[K];
+    };
+
+private:
+    enum vertex_status : char { PRE_HEAP = 0, IN_HEAP = 1, POST_HEAP = 2 };
+    struct csr_arc {
+        std::uint32_t other_end;
+        value_t length;
+    };
+    using heap = fhamonic::melon::d_ary_heap<
+        4, std::uint32_t, value_t,
+        decltype([](const auto & e1, const auto & e2) {
+            return e1.second < e2.second;
+        }),
+        std::vector<std::size_t>>;
+
+    static constexpr value_t infinity = std::numeric_limits<value_t>::max();
+
+    std::vector<std::uint32_t> _new_id_map;
+    std::vector<std::size_t> _up_arcs_begin;
+    std::vector<csr_arc> _up_arcs;
+    std::vector<std::size_t> _down_arcs_begin;
+    std::vector<csr_arc> _down_arcs;
+    std::vector<lanes> _dist_map;
+    std::vector<vertex_status> _status_map;
+    std::vector<std::uint32_t> _visited;
+    heap _heap;
+    std::size_t _nb_upward_scans;
+
+public:
+    [[nodiscard]] explicit phast(const hierarchy & ch)
+        : _new_id_map(ch.nb_vertices())
+        , _up_arcs_begin(ch.nb_vertices() + 1)
+        , _down_arcs_begin(ch.nb_vertices() + 1)
+        , _dist_map(ch.nb_vertices())
+        , _status_map(ch.nb_vertices(), PRE_HEAP)
+        , _heap(std::vector<std::size_t>(ch.nb_vertices()))
+        , _nb_upward_scans(0) {
+        const std::size_t n = ch.nb_vertices();
+        std::vector<vertex> order(n);
+        for(std::size_t u = 0; u < n; ++u) {
+            const std::uint32_t new_id =
+                static_cast<std::uint32_t>(n - 1 - ch.rank(vertex(u)));
+            _new_id_map[u] = new_id;
+            order[new_id] = vertex(u);
+        }
+        _up_arcs_begin[0] = _down_arcs_begin[0] = 0;
+        for(std::size_t i = 0; i < n; ++i) {
+            for(auto && [w, length] : ch.up_arcs(order[i]))
+                _up_arcs.push_back({_new_id_map[w], length});
+            for(auto && [u, length] : ch.down_in_arcs(order[i]))
+                _down_arcs.push_back({_new_id_map[u], length});
+            _up_arcs_begin[i + 1] = _up_arcs.size();
+            _down_arcs_begin[i + 1] = _down_arcs.size();
+        }
+    }
+
+    [[nodiscard]] static constexpr std::size_t nb_lanes() noexcept {
+        return K;
+    }
+    [[nodiscard]] std::size_t nb_upward_scans() const noexcept {
+        return _nb_upward_scans;
+    }
+    [[nodiscard]] value_t dist(const std::size_t lane,
+                               const vertex u) const noexcept {
+        return _dist_map[_new_id_map[u]].lane[lane];
+    }
+    [[nodiscard]] value_t dist(const vertex u) const noexcept
+        requires(K == 1)
+    {
+        return _dist_map[_new_id_map[u]].lane[0];
+    }
+    [[nodiscard]] bool reached(const std::size_t lane,
+                               const vertex u) const noexcept {
+        return dist(lane, u) != infinity;
+    }
+
+private:
+    void upward_search(const std::size_t lane, const std::uint32_t s) {
+        _heap.push(s, value_t{0});
+        _status_map[s] = IN_HEAP;
+        _visited.push_back(s);
+        while(!_heap.empty()) {
+            const auto [u, u_dist] = _heap.top();
+            _heap.pop();
+            _status_map[u] = POST_HEAP;
+            _dist_map[u].lane[lane] = u_dist;
+            ++_nb_upward_scans;
+            for(std::size_t i = _up_arcs_begin[u]; i < _up_arcs_begin[u + 1];
+                ++i) {
+                const auto [w, length] = _up_arcs[i];
+                const value_t new_dist = u_dist + length;
+                if(_status_map[w] == IN_HEAP) {
+                    if(new_dist < _heap.priority(w))
+                        _heap.promote(w, new_dist);
+                } else if(_status_map[w] == PRE_HEAP) {
+                    _heap.push(w, new_dist);
+                    _status_map[w] = IN_HEAP;
+                    _visited.push_back(w);
+                }
+            }
+        }
+        for(const std::uint32_t u : _visited) _status_map[u] = PRE_HEAP;
+        _visited.clear();
+    }
+
+    void downward_sweep() {
+        const std::size_t n = _dist_map.size();
+        for(std::size_t v = 0; v < n; ++v) {
+            lanes v_dist = _dist_map[v];
+            for(std::size_t i = _down_arcs_begin[v];
+                i < _down_arcs_begin[v + 1]; ++i) {
+                const auto [u, length] = _down_arcs[i];
+                const lanes & u_dist = _dist_map[u];
+                for(std::size_t j = 0; j < K; ++j) {
+                    const value_t new_dist = u_dist.lane[j] + length;
+                    v_dist.lane[j] =
+                        new_dist < v_dist.lane[j] ? new_dist : v_dist.lane[j];
+                }
+            }
+            _dist_map[v] = v_dist;
+        }
+    }
+
+public:
+    void run(const std::array<vertex, K> & sources) {
+        lanes infinities;
+        for(std::size_t i = 0; i < K; ++i) infinities.lane[i] = infinity;
+        for(auto & d : _dist_map) d = infinities;
+        _nb_upward_scans = 0;
+        for(std::size_t i = 0; i < K; ++i)
+            upward_search(i, _new_id_map[sources[i]]);
+        downward_sweep();
+    }
+    void run(const vertex s)
+        requires(K == 1)
+    {
+        run(std::array<vertex, 1>{s});
+    }
+};
+
+#endif  // PHAST_HPP
@@ -0,0 +1,156 @@
+#ifndef PIECEWISE_LINEAR_FUNCTIONS_HPP
+#define PIECEWISE_LINEAR_FUNCTIONS_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+/**
+ * @brief Periodic piecewise linear travel time functions of the arcs, stored
+ * in a flat arena.
+ *
+ * The breakpoints of all the functions are stored contiguously, in the
+ * order of the arc ids, and an offsets array gives the range of each arc.
+ * A function with a single breakpoint is constant. Breakpoints hold single
+ * precision departure times in [0, period) and travel times, and the
+ * function is linearly interpolated between them, wrapping around the
+ * period. The functions are expected to satisfy the FIFO property (slopes
+ * greater than -1), so that departing later never means arriving earlier.
+ */
+class piecewise_linear_functions {
+public:
+    struct breakpoint {
+        float time;
+        float travel_time;
+    };
+
+private:
+    double _period;
+    std::vector<std::uint32_t> _offsets;
+    std::vector<breakpoint> _breakpoints;
+
+public:
+    [[nodiscard]] explicit piecewise_linear_functions(const double period)
+        : _period(period), _offsets{0}, _breakpoints() {}
+
+    [[nodiscard]] double period() const noexcept { return _period; }
+    [[nodiscard]] std::size_t nb_functions() const noexcept {
+        return _offsets.size() - 1;
+    }
+    [[nodiscard]] std::size_t nb_breakpoints() const noexcept {
+        return _breakpoints.size();
+    }
+    [[nodiscard]] std::size_t memory_bytes() const noexcept {
+        return _offsets.size() * sizeof(std::uint32_t) +
+               _breakpoints.size() * sizeof(breakpoint);
+    }
+
+    // Appends the function of the next arc id, breakpoints sorted by time
+    template <typename It>
+    void push_back(It first, It last) {
+        assert(first != last);
+        _breakpoints.insert(_breakpoints.end(), first, last);
+        assert(_breakpoints.size() <=
+               std::numeric_limits<std::uint32_t>::max());
+        _offsets.push_back(static_cast<std::uint32_t>(_breakpoints.size()));
+    }
+
+    [[nodiscard]] double travel_time(const std::size_t f,
+                                     const double departure) const noexcept {
+        const breakpoint * first = _breakpoints.data() + _offsets[f];
+        const breakpoint * last = _breakpoints.data() + _offsets[f + 1];
+        if(last - first == 1) return first->travel_time;
+
+        const double t = departure - _period * std::floor(departure / _period);
+        const breakpoint * next = std::upper_bound(
+            first, last, t,
+            [](const double time, const breakpoint & b) {
+                return time < b.time;
+            });
+        double prev_time, next_time;
+        const breakpoint * prev;
+        if(next == first) {
+            prev = last - 1;
+            prev_time = prev->time - _period;
+        } else {
+            prev = next - 1;
+            prev_time = prev->time;
+        }
+        if(next == last) {
+            next = first;
+            next_time = next->time + _period;
+        } else {
+            next_time = next->time;
+        }
+        const double ratio = (t - prev_time) / (next_time - prev_time);
+        return prev->travel_time +
+               ratio * (next->travel_time - prev->travel_time);
+    }
+    [[nodiscard]] double arrival_time(const std::size_t f,
+                                      const double departure) const noexcept {
+        return departure + travel_time(f, departure);
+    }
+};
+
+/**
+ * Synthetic daily profiles from static travel times: a ratio of the arcs,
+ * drawn at random, get nb_breakpoints evenly spaced breakpoints following a
+ * morning and an evening rush hour scaled by a random congestion factor,
+ * and the other arcs keep their constant travel time. Decreases are
+ * smoothed so that the functions satisfy the FIFO property.
+ */
+template <typename Graph, typename LengthMap>
+piecewise_linear_functions generate_travel_time_profiles(
+    const Graph & g, const LengthMap & l, const std::size_t nb_breakpoints,
+    const double congested_ratio, const double period,
+    const unsigned int seed = 1234) {
+    constexpr double max_decrease_slope = 0.9;
+    auto rush_hours = [](const double x) {
+        auto peak = [x](const double center, const double width) {
+            const double d = (x - center) / width;
+            return std::exp(-d * d);
+        };
+        return peak(8.0 / 24.0, 1.0 / 24.0) + peak(18.0 / 24.0, 1.5 / 24.0);
+    };
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> ratio_dist(0.0, 1.0);
+    std::uniform_real_distribution<double> congestion_dist(0.2, 1.0);
+    piecewise_linear_functions functions(period);
+    std::vector<piecewise_linear_functions::breakpoint> breakpoints;
+    for(auto && a : g.arcs()) {
+        const double length = static_cast<double>(l[a]);
+        breakpoints.clear();
+        if(nb_breakpoints <= 1 || ratio_dist(rng) >= congested_ratio) {
+            breakpoints.push_back({0.0f, static_cast<float>(length)});
+            functions.push_back(breakpoints.begin(), breakpoints.end());
+            continue;
+        }
+        const double congestion = congestion_dist(rng);
+        const double step = period / static_cast<double>(nb_breakpoints);
+        for(std::size_t i = 0; i < nb_breakpoints; ++i) {
+            const double t = static_cast<double>(i) * step;
+            const double factor = 1.0 + congestion * rush_hours(t / period);
+            breakpoints.push_back(
+                {static_cast<float>(t), static_cast<float>(length * factor)});
+        }
+        // two rounds around the period reach the fixpoint of the smoothing
+        for(std::size_t i = 1; i < 2 * nb_breakpoints + 1; ++i) {
+            const auto & prev = breakpoints[(i - 1) % nb_breakpoints];
+            auto & b = breakpoints[i % nb_breakpoints];
+            b.travel_time =
+                std::max(b.travel_time,
+                         static_cast<float>(prev.travel_time -
+                                            max_decrease_slope * step));
+        }
+        functions.push_back(breakpoints.begin(), breakpoints.end());
+    }
+    return functions;
+}
+
+#endif  // PIECEWISE_LINEAR_FUNCTIONS_HPP
@@ -0,0 +1,149 @@
+#ifndef RADIX_HEAP_HPP
+#define RADIX_HEAP_HPP
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Monotone radix heap with decrease-key, usable as the heap of
+ * melon's dijkstra for unsigned integer lengths.
+ *
+ * Entries are spread in buckets according to the highest bit that differs
+ * between their priority and the last extracted one. Pushed and promoted
+ * priorities must not be smaller than the last priority returned by top().
+ * The indices map stores, for each id in the heap, its bucket in the high
+ * half of the word and its position in that bucket in the low half.
+ */
+template <typename ID, typename PRIO,
+          typename IndicesMap = std::vector<std::size_t>>
+class radix_heap {
+    static_assert(std::is_unsigned_v<PRIO>,
+                  "radix_heap requires unsigned integer priorities");
+    static_assert(sizeof(std::size_t) >= 8,
+                  "radix_heap encodes bucket and position in a 64 bits index");
+
+public:
+    using id_type = ID;
+    using priority_type = PRIO;
+    using entry = std::pair<id_type, priority_type>;
+    using indices_map = IndicesMap;
+
+private:
+    static constexpr std::size_t nb_buckets =
+        std::numeric_limits<PRIO>::digits + 1;
+    static constexpr std::size_t position_bits = 32;
+    static constexpr std::size_t position_mask =
+        (std::size_t{1} << position_bits) - 1;
+
+    mutable std::array<std::vector<entry>, nb_buckets> _buckets;
+    mutable IndicesMap _indices_map;
+    mutable PRIO _last;
+    std::size_t _size;
+
+public:
+    [[nodiscard]] constexpr explicit radix_heap(IndicesMap && indices)
+        : _buckets()
+        , _indices_map(std::move(indices))
+        , _last(0)
+        , _size(0) {}
+
+    constexpr radix_heap(const radix_heap &) = default;
+    constexpr radix_heap(radix_heap &&) = default;
+    constexpr radix_heap & operator=(const radix_heap &) = default;
+    constexpr radix_heap & operator=(radix_heap &&) = default;
+
+    [[nodiscard]] constexpr std::size_t size() const noexcept { return _size; }
+    [[nodiscard]] constexpr bool empty() const noexcept { return _size == 0; }
+    constexpr void clear() noexcept {
+        for(auto & bucket : _buckets) bucket.clear();
+        _last = 0;
+        _size = 0;
+    }
+
+private:
+    [[nodiscard]] constexpr std::size_t bucket_of(const PRIO p) const noexcept {
+        return static_cast<std::size_t>(std::bit_width(p ^ _last));
+    }
+    [[nodiscard]] static constexpr std::size_t encode(
+        const std::size_t bucket, const std::size_t position) noexcept {
+        return (bucket << position_bits) | position;
+    }
+    [[nodiscard]] static constexpr std::size_t bucket_index(
+        const std::size_t index) noexcept {
+        return index >> position_bits;
+    }
+    [[nodiscard]] static constexpr std::size_t position_index(
+        const std::size_t index) noexcept {
+        return index & position_mask;
+    }
+
+    constexpr void insert(const entry & e) const noexcept {
+        const std::size_t b = bucket_of(e.second);
+        _indices_map[e.first] = encode(b, _buckets[b].size());
+        _buckets[b].push_back(e);
+    }
+    constexpr void erase(const std::size_t b, const std::size_t pos) noexcept {
+        auto & bucket = _buckets[b];
+        if(pos + 1 != bucket.size()) {
+            bucket[pos] = bucket.back();
+            _indices_map[bucket[pos].first] = encode(b, pos);
+        }
+        bucket.pop_back();
+    }
+    // Ensures that the first bucket contains the minimal entries
+    constexpr void refill() const noexcept {
+        if(!_buckets[0].empty()) return;
+        std::size_t b = 1;
+        while(_buckets[b].empty()) ++b;
+        auto & bucket = _buckets[b];
+        PRIO min = bucket.front().second;
+        for(const auto & e : bucket) min = std::min(min, e.second);
+        _last = min;
+        for(const auto & e : bucket) insert(e);
+        bucket.clear();
+    }
+
+public:
+    constexpr void push(const id_type & id, const priority_type & p) noexcept {
+        assert(p >= _last);
+        insert(entry(id, p));
+        ++_size;
+    }
+    [[nodiscard]] constexpr const priority_type & priority(
+        const id_type & id) const noexcept {
+        const std::size_t index = _indices_map[id];
+        return _buckets[bucket_index(index)][position_index(index)].second;
+    }
+    constexpr void promote(const id_type & id,
+                           const priority_type & p) noexcept {
+        assert(p >= _last);
+        const std::size_t index = _indices_map[id];
+        const std::size_t b = bucket_index(index);
+        const std::size_t new_b = bucket_of(p);
+        if(new_b == b) {
+            _buckets[b][position_index(index)].second = p;
+            return;
+        }
+        erase(b, position_index(index));
+        insert(entry(id, p));
+    }
+    [[nodiscard]] constexpr entry top() const noexcept {
+        assert(!empty());
+        refill();
+        return _buckets[0].back();
+    }
+    constexpr void pop() noexcept {
+        assert(!empty());
+        refill();
+        _buckets[0].pop_back();
+        --_size;
+    }
+};
+
+#endif  // RADIX_HEAP_HPP
@@ -0,0 +1,283 @@
+#ifndef SEQUENCE_HEAP_HPP
+#define SEQUENCE_HEAP_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Sequence heap with lazy decrease-key, following the interface of
+ * melon's d_ary_heap.
+ *
+ * New entries go into a small binary heap that fits in the L1 cache. When it
+ * is full, it is sorted into a run of level 0, and merge_degree runs of a
+ * same level are merged into a run of the next level, as in the groups of
+ * Sanders' sequence heap. The minimum is the smallest of the top of the
+ * insertion heap and of the heads of the runs, kept in a binary heap.
+ * promote() inserts a new entry, and the outdated entries of an id are
+ * skipped when they reach the top or dropped when their run is merged.
+ * The current priority of the ids is stored in vectors grown on demand, the
+ * indices map is only taken for compatibility with the heaps of melon.
+ */
+template <typename ID, typename PRIO, typename PRIO_COMPARE = std::less<PRIO>,
+          typename IndicesMap = std::vector<std::size_t>>
+class sequence_heap {
+public:
+    using id_type = ID;
+    using priority_type = PRIO;
+    using entry = std::pair<id_type, priority_type>;
+    using indices_map = IndicesMap;
+
+private:
+    static constexpr std::size_t insertion_heap_capacity = 256;
+    static constexpr std::size_t merge_degree = 8;
+
+    struct run {
+        std::vector<entry> entries;
+        std::size_t begin;
+        std::size_t level;
+
+        [[nodiscard]] bool exhausted() const noexcept {
+            return begin == entries.size();
+        }
+        [[nodiscard]] const entry & head() const noexcept {
+            return entries[begin];
+        }
+    };
+
+    mutable std::vector<entry> _insertion_heap;
+    mutable std::vector<run> _runs;
+    mutable std::vector<std::size_t> _free_runs;
+    mutable std::vector<std::vector<std::size_t>> _levels;
+    mutable std::vector<std::size_t> _runs_heap;
+    std::vector<entry> _merge_buffer;
+    std::vector<priority_type> _priorities;
+    std::vector<char> _in_heap;
+    [[no_unique_address]] PRIO_COMPARE _cmp;
+    std::size_t _size;
+
+public:
+    [[nodiscard]] constexpr explicit sequence_heap(
+        IndicesMap &&, PRIO_COMPARE && cmp = PRIO_COMPARE())
+        : _insertion_heap()
+        , _runs()
+        , _free_runs()
+        , _levels()
+        , _runs_heap()
+        , _merge_buffer()
+        , _priorities()
+        , _in_heap()
+        , _cmp(std::move(cmp))
+        , _size(0) {
+        _insertion_heap.reserve(insertion_heap_capacity);
+    }
+
+    sequence_heap(const sequence_heap &) = default;
+    sequence_heap(sequence_heap &&) = default;
+    sequence_heap & operator=(const sequence_heap &) = default;
+    sequence_heap & operator=(sequence_heap &&) = default;
+
+    [[nodiscard]] std::size_t size() const noexcept { return _size; }
+    [[nodiscard]] bool empty() const noexcept { return _size == 0; }
+    void clear() noexcept {
+        _insertion_heap.clear();
+        _runs.clear();
+        _free_runs.clear();
+        _levels.clear();
+        _runs_heap.clear();
+        std::fill(_in_heap.begin(), _in_heap.end(), char{0});
+        _size = 0;
+    }
+
+private:
+    [[nodiscard]] bool entry_less(const entry & e1,
+                                  const entry & e2) const noexcept {
+        return _cmp(e1.second, e2.second);
+    }
+    [[nodiscard]] bool entry_greater(const entry & e1,
+                                     const entry & e2) const noexcept {
+        return _cmp(e2.second, e1.second);
+    }
+    [[nodiscard]] bool run_greater(const std::size_t r1,
+                                   const std::size_t r2) const noexcept {
+        return entry_greater(_runs[r1].head(), _runs[r2].head());
+    }
+    [[nodiscard]] bool outdated(const entry & e) const noexcept {
+        const auto id = static_cast<std::size_t>(e.first);
+        return !_in_heap[id] || _priorities[id] != e.second;
+    }
+
+    void push_runs_heap(const std::size_t r) const {
+        _runs_heap.push_back(r);
+        std::push_heap(
+            _runs_heap.begin(), _runs_heap.end(),
+            [this](std::size_t a, std::size_t b) { return run_greater(a, b); });
+    }
+    void rebuild_runs_heap() const {
+        _runs_heap.clear();
+        for(const auto & level : _levels)
+            for(const std::size_t r : level) _runs_heap.push_back(r);
+        std::make_heap(
+            _runs_heap.begin(), _runs_heap.end(),
+            [this](std::size_t a, std::size_t b) { return run_greater(a, b); });
+    }
+    [[nodiscard]] std::size_t new_run(const std::size_t level) {
+        std::size_t r;
+        if(_free_runs.empty()) {
+            r = _runs.size();
+            _runs.emplace_back();
+        } else {
+            r = _free_runs.back();
+            _free_runs.pop_back();
+        }
+        _runs[r].begin = 0;
+        _runs[r].level = level;
+        if(_levels.size() <= level) _levels.resize(level + 1);
+        _levels[level].push_back(r);
+        return r;
+    }
+    void release_run(const std::size_t r) const {
+        auto & level = _levels[_runs[r].level];
+        level.erase(std::find(level.begin(), level.end(), r));
+        _runs[r].entries.clear();
+        _free_runs.push_back(r);
+    }
+    // Advances the run on top of the runs heap
+    void pop_runs_heap_head() const {
+        auto greater = [this](std::size_t a, std::size_t b) {
+            return run_greater(a, b);
+        };
+        std::pop_heap(_runs_heap.begin(), _runs_heap.end(), greater);
+        const std::size_t r = _runs_heap.back();
+        _runs_heap.pop_back();
+        ++_runs[r].begin;
+        if(_runs[r].exhausted())
+            release_run(r);
+        else
+            push_runs_heap(r);
+    }
+    void pop_insertion_heap() const {
+        std::pop_heap(_insertion_heap.begin(), _insertion_heap.end(),
+                      [this](const entry & a, const entry & b) {
+                          return entry_greater(a, b);
+                      });
+        _insertion_heap.pop_back();
+    }
+    void discard_outdated() const {
+        while(!_insertion_heap.empty() && outdated(_insertion_heap.front()))
+            pop_insertion_heap();
+        while(!_runs_heap.empty() && outdated(_runs[_runs_heap.front()].head()))
+            pop_runs_heap_head();
+    }
+
+    // Merges the runs of a full level into one run of the next level
+    void merge_level(const std::size_t level) {
+        _merge_buffer.clear();
+        std::vector<std::size_t> bounds{0};
+        for(const std::size_t r : _levels[level]) {
+            const auto & entries = _runs[r].entries;
+            for(std::size_t i = _runs[r].begin; i < entries.size(); ++i)
+                if(!outdated(entries[i])) _merge_buffer.push_back(entries[i]);
+            bounds.push_back(_merge_buffer.size());
+            _runs[r].entries.clear();
+            _free_runs.push_back(r);
+        }
+        _levels[level].clear();
+        auto less = [this](const entry & a, const entry & b) {
+            return entry_less(a, b);
+        };
+        for(std::size_t step = 1; step + 1 < bounds.size(); step *= 2) {
+            for(std::size_t i = 0; i + step + 1 < bounds.size(); i += 2 * step)
+                std::inplace_merge(
+                    _merge_buffer.begin() + bounds[i],
+                    _merge_buffer.begin() + bounds[i + step],
+                    _merge_buffer.begin() +
+                        bounds[std::min(i + 2 * step, bounds.size() - 1)],
+                    less);
+        }
+        if(_merge_buffer.empty()) return;
+        const std::size_t r = new_run(level + 1);
+        _runs[r].entries.swap(_merge_buffer);
+        if(_levels[level + 1].size() == merge_degree) merge_level(level + 1);
+    }
+    // Sorts the insertion heap into a run of level 0
+    void flush_insertion_heap() {
+        std::erase_if(_insertion_heap,
+                      [this](const entry & e) { return outdated(e); });
+        std::sort(_insertion_heap.begin(), _insertion_heap.end(),
+                  [this](const entry & a, const entry & b) {
+                      return entry_less(a, b);
+                  });
+        if(!_insertion_heap.empty()) {
+            const std::size_t r = new_run(0);
+            _runs[r].entries.assign(_insertion_heap.begin(),
+                                    _insertion_heap.end());
+            if(_levels[0].size() == merge_degree) merge_level(0);
+            rebuild_runs_heap();
+        }
+        _insertion_heap.clear();
+    }
+    void insert(const entry & e) {
+        if(_insertion_heap.size() == insertion_heap_capacity)
+            flush_insertion_heap();
+        _insertion_heap.push_back(e);
+        std::push_heap(_insertion_heap.begin(), _insertion_heap.end(),
+                       [this](const entry & a, const entry & b) {
+                           return entry_greater(a, b);
+                       });
+    }
+    // true if the minimum is on top of the insertion heap
+    [[nodiscard]] bool min_in_insertion_heap() const noexcept {
+        if(_runs_heap.empty()) return true;
+        if(_insertion_heap.empty()) return false;
+        return !entry_greater(_insertion_heap.front(),
+                              _runs[_runs_heap.front()].head());
+    }
+
+public:
+    void push(const id_type & id, const priority_type & p) {
+        const auto i = static_cast<std::size_t>(id);
+        if(i >= _in_heap.size()) {
+            _in_heap.resize(i + 1, char{0});
+            _priorities.resize(i + 1);
+        }
+        assert(!_in_heap[i]);
+        _in_heap[i] = 1;
+        _priorities[i] = p;
+        insert(entry(id, p));
+        ++_size;
+    }
+    [[nodiscard]] const priority_type & priority(
+        const id_type & id) const noexcept {
+        return _priorities[static_cast<std::size_t>(id)];
+    }
+    void promote(const id_type & id, const priority_type & p) {
+        _priorities[static_cast<std::size_t>(id)] = p;
+        insert(entry(id, p));
+    }
+    [[nodiscard]] entry top() const {
+        assert(!empty());
+        discard_outdated();
+        return min_in_insertion_heap() ? _insertion_heap.front()
+                                       : _runs[_runs_heap.front()].head();
+    }
+    void pop() {
+        assert(!empty());
+        discard_outdated();
+        if(min_in_insertion_heap()) {
+            _in_heap[static_cast<std::size_t>(_insertion_heap.front().first)] =
+                0;
+            pop_insertion_heap();
+        } else {
+            _in_heap[static_cast<std::size_t>(
+                _runs[_runs_heap.front()].head().first)] = 0;
+            pop_runs_heap_head();
+        }
+        --_size;
+    }
+};
+
+#endif  // SEQUENCE_HEAP_HPP
@@ -0,0 +1,100 @@
+#ifndef TIME_DEPENDENT_DIJKSTRA_HPP
+#define TIME_DEPENDENT_DIJKSTRA_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "melon/algorithm/dijkstra.hpp"
+#include "melon/container/static_digraph.hpp"
+
+#include "piecewise_linear_functions.hpp"
+
+/**
+ * @brief Earliest arrival Dijkstra on time dependent arc travel times.
+ *
+ * The labels are arrival times and relaxing an arc evaluates its travel
+ * time function at the arrival time at its source, which gives the earliest
+ * arrival times when the functions satisfy the FIFO property. The heap is
+ * taken from the traits as for melon's dijkstra, with double priorities,
+ * and the buffers are kept between queries.
+ */
+template <typename Graph, typename Traits>
+class time_dependent_dijkstra {
+public:
+    using vertex = fhamonic::melon::vertex_t<Graph>;
+    using arc = fhamonic::melon::arc_t<Graph>;
+    using traversal_entry = std::pair<vertex, double>;
+
+private:
+    enum vertex_status : char { PRE_HEAP = 0, IN_HEAP = 1, POST_HEAP = 2 };
+
+    std::reference_wrapper<const Graph> _graph;
+    std::reference_wrapper<const piecewise_linear_functions> _functions;
+    typename Traits::heap _heap;
+    std::vector<vertex_status> _status_map;
+    std::vector<double> _arrival_map;
+
+public:
+    [[nodiscard]] time_dependent_dijkstra(
+        Traits, const Graph & g, const piecewise_linear_functions & functions)
+        : _graph(std::cref(g))
+        , _functions(std::cref(functions))
+        , _heap(fhamonic::melon::create_vertex_map<std::size_t>(g))
+        , _status_map(g.nb_vertices(), PRE_HEAP)
+        , _arrival_map(g.nb_vertices()) {
+        assert(functions.nb_functions() == g.nb_arcs());
+    }
+
+    void reset() noexcept {
+        _heap.clear();
+        std::fill(_status_map.begin(), _status_map.end(), PRE_HEAP);
+    }
+
+    [[nodiscard]] bool reached(const vertex u) const noexcept {
+        return _status_map[u] != PRE_HEAP;
+    }
+    [[nodiscard]] double arrival_time(const vertex u) const noexcept {
+        assert(_status_map[u] == POST_HEAP);
+        return _arrival_map[u];
+    }
+
+    void add_source(const vertex s, const double departure_time) {
+        assert(!reached(s));
+        _heap.push(s, departure_time);
+        _status_map[s] = IN_HEAP;
+    }
+    [[nodiscard]] bool finished() const noexcept { return _heap.empty(); }
+    [[nodiscard]] traversal_entry current() const noexcept {
+        assert(!finished());
+        return _heap.top();
+    }
+    void advance() {
+        const Graph & g = _graph.get();
+        const piecewise_linear_functions & functions = _functions.get();
+        const auto [u, u_arrival] = _heap.top();
+        _heap.pop();
+        _status_map[u] = POST_HEAP;
+        _arrival_map[u] = u_arrival;
+        for(auto && a : g.out_arcs(u)) {
+            const vertex w = g.arc_target(a);
+            if(_status_map[w] == IN_HEAP) {
+                const double new_arrival =
+                    functions.arrival_time(a, u_arrival);
+                if(new_arrival < _heap.priority(w))
+                    _heap.promote(w, new_arrival);
+            } else if(_status_map[w] == PRE_HEAP) {
+                _heap.push(w, functions.arrival_time(a, u_arrival));
+                _status_map[w] = IN_HEAP;
+            }
+        }
+    }
+    void run() {
+        while(!finished()) advance();
+    }
+};
+
+#endif  // TIME_DEPENDENT_DIJKSTRA_HPP
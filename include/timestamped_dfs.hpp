@@ -0,0 +1,160 @@
+#ifndef TIMESTAMPED_DFS_HPP
+#define TIMESTAMPED_DFS_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+#include "melon/container/static_digraph.hpp"
+
+/**
+ * @brief Visitor of timestamped_dfs whose callbacks do nothing. Visitors
+ * derive from it and hide the callbacks they need, which the search calls
+ * statically, so that the others compile out.
+ */
+struct null_dfs_visitor {
+    template <typename V>
+    void discover_vertex(const V &) const noexcept {}
+    template <typename V>
+    void finish_vertex(const V &) const noexcept {}
+    template <typename A, typename V>
+    void tree_arc(const A &, const V &, const V &) const noexcept {}
+    template <typename A, typename V>
+    void back_arc(const A &, const V &, const V &) const noexcept {}
+    template <typename A, typename V>
+    void forward_arc(const A &, const V &, const V &) const noexcept {}
+    template <typename A, typename V>
+    void cross_arc(const A &, const V &, const V &) const noexcept {}
+};
+
+/**
+ * @brief Non recursive depth first search recording the pre-order and
+ * post-order numbers of the vertices and classifying the arcs.
+ *
+ * The stack holds, for each vertex on the current path, the position of the
+ * next arc to explore in its out arcs. An arc u->v whose target is already
+ * discovered is a back arc if v is not finished, a forward arc if v was
+ * discovered after u and a cross arc otherwise. Successive runs from several
+ * sources build a depth first forest until reset() is called; run() without
+ * source covers every vertex, e.g. for topological sorting by decreasing
+ * post-order numbers.
+ */
+template <typename Graph, typename Visitor = null_dfs_visitor>
+class timestamped_dfs {
+public:
+    using vertex = fhamonic::melon::vertex_t<Graph>;
+    using arc = fhamonic::melon::arc_t<Graph>;
+    static constexpr std::uint32_t unvisited =
+        std::numeric_limits<std::uint32_t>::max();
+
+private:
+    using out_arcs_range = decltype(std::declval<const Graph &>().out_arcs(
+        std::declval<vertex>()));
+    // the stack keeps iterators after the range they come from is destroyed
+    static_assert(std::ranges::borrowed_range<out_arcs_range>);
+    struct frame {
+        vertex u;
+        std::ranges::iterator_t<out_arcs_range> next_arc;
+        std::ranges::sentinel_t<out_arcs_range> arcs_end;
+    };
+
+    std::reference_wrapper<const Graph> _graph;
+    [[no_unique_address]] Visitor _visitor;
+    std::vector<std::uint32_t> _pre_order_map;
+    std::vector<std::uint32_t> _post_order_map;
+    std::uint32_t _nb_discovered;
+    std::uint32_t _nb_finished;
+    std::vector<frame> _stack;
+
+public:
+    [[nodiscard]] explicit timestamped_dfs(const Graph & g,
+                                           Visitor visitor = {})
+        : _graph(std::cref(g))
+        , _visitor(std::move(visitor))
+        , _pre_order_map(g.nb_vertices(), unvisited)
+        , _post_order_map(g.nb_vertices(), unvisited)
+        , _nb_discovered(0)
+        , _nb_finished(0) {}
+
+    [[nodiscard]] Visitor & visitor() noexcept { return _visitor; }
+    [[nodiscard]] const Visitor & visitor() const noexcept { return _visitor; }
+
+    [[nodiscard]] bool discovered(const vertex u) const noexcept {
+        return _pre_order_map[u] != unvisited;
+    }
+    [[nodiscard]] bool finished(const vertex u) const noexcept {
+        return _post_order_map[u] != unvisited;
+    }
+    [[nodiscard]] std::uint32_t pre_order(const vertex u) const noexcept {
+        assert(discovered(u));
+        return _pre_order_map[u];
+    }
+    [[nodiscard]] std::uint32_t post_order(const vertex u) const noexcept {
+        assert(finished(u));
+        return _post_order_map[u];
+    }
+    [[nodiscard]] std::uint32_t nb_discovered() const noexcept {
+        return _nb_discovered;
+    }
+
+    void reset() noexcept {
+        std::fill(_pre_order_map.begin(), _pre_order_map.end(), unvisited);
+        std::fill(_post_order_map.begin(), _post_order_map.end(), unvisited);
+        _nb_discovered = 0;
+        _nb_finished = 0;
+    }
+
+    // Explores the vertices reachable from s that are not yet discovered
+    void run(const vertex s) {
+        if(discovered(s)) return;
+        const Graph & g = _graph.get();
+        discover(s);
+        while(!_stack.empty()) {
+            frame & f = _stack.back();
+            if(f.next_arc == f.arcs_end) {
+                finish(f.u);
+                _stack.pop_back();
+                continue;
+            }
+            const vertex u = f.u;
+            const arc a = *f.next_arc;
+            ++f.next_arc;
+            const vertex v = g.arc_target(a);
+            if(!discovered(v)) {
+                _visitor.tree_arc(a, u, v);
+                discover(v);  // invalidates f
+            } else if(!finished(v)) {
+                _visitor.back_arc(a, u, v);
+            } else if(_pre_order_map[v] > _pre_order_map[u]) {
+                _visitor.forward_arc(a, u, v);
+            } else {
+                _visitor.cross_arc(a, u, v);
+            }
+        }
+    }
+    // Explores the whole graph, rooting a new tree at each vertex not yet
+    // discovered
+    void run() {
+        for(auto && u : _graph.get().vertices()) run(u);
+    }
+
+private:
+    void discover(const vertex u) {
+        _pre_order_map[u] = _nb_discovered++;
+        _visitor.discover_vertex(u);
+        auto && out_arcs = _graph.get().out_arcs(u);
+        _stack.push_back(
+            {u, std::ranges::begin(out_arcs), std::ranges::end(out_arcs)});
+    }
+    void finish(const vertex u) {
+        _post_order_map[u] = _nb_finished++;
+        _visitor.finish_vertex(u);
+    }
+};
+
+#endif  // TIMESTAMPED_DFS_HPP
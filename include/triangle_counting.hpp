@@ -0,0 +1,315 @@
+#ifndef TRIANGLE_COUNTING_HPP
+#define TRIANGLE_COUNTING_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <thread>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "melon/container/static_digraph.hpp"
+
+enum class intersection_strategy : char {
+    merge,      // linear merge of the two lists
+    galloping,  // exponential then binary search of the shorter list
+    simd        // all pairs comparisons of blocks of the two lists
+};
+
+/**
+ * @brief Parallel triangle counting over a degree ordered DAG.
+ *
+ * The arcs are seen as edges, without loops nor parallel edges. The
+ * vertices are renumbered by nondecreasing degree and every edge is
+ * oriented toward its end of larger number, so that every triangle is
+ * counted once, from its smallest vertex u, as an element of
+ * N+(u) & N+(v) for an out neighbor v of u, and that the out degrees are
+ * at most the square root of twice the number of edges. The out neighbors
+ * are stored sorted in a CSR, the elements of N+(u) that are greater than
+ * v only being intersected with N+(v), with the strategy given as template
+ * parameter. The simd strategy compares blocks of 8 (AVX2) or 4 (SSE2)
+ * vertices by rotations, and falls back to a scalar block comparison on
+ * other targets. The threads take chunks of vertices from an atomic
+ * counter since the work per vertex is very irregular.
+ */
+template <typename Graph,
+          intersection_strategy Strategy = intersection_strategy::merge>
+class triangle_counting {
+private:
+    static constexpr std::size_t chunk_size = 64;
+
+    std::size_t _nb_vertices;
+    std::size_t _nb_threads;
+    std::vector<std::size_t> _out_begin;
+    std::vector<std::uint32_t> _out_neighbors;
+    std::uint64_t _nb_wedges;
+    std::atomic<std::size_t> _next_chunk;
+    std::atomic<std::uint64_t> _nb_triangles;
+
+public:
+    [[nodiscard]] explicit triangle_counting(const Graph & g,
+                                             const std::size_t nb_threads = 1)
+        : _nb_vertices(g.nb_vertices())
+        , _nb_threads(std::max(nb_threads, std::size_t{1}))
+        , _out_begin(g.nb_vertices() + 1, 0)
+        , _nb_wedges(0)
+        , _next_chunk(0)
+        , _nb_triangles(0) {
+        build_dag(g);
+    }
+
+    [[nodiscard]] std::size_t nb_threads() const noexcept {
+        return _nb_threads;
+    }
+    // number of edges, i.e. of arcs of the DAG
+    [[nodiscard]] std::size_t nb_edges() const noexcept {
+        return _out_neighbors.size();
+    }
+    [[nodiscard]] std::uint64_t nb_triangles() const noexcept {
+        return _nb_triangles.load(std::memory_order_relaxed);
+    }
+    // number of paths of length 2, i.e. sum of d(u) * (d(u) - 1) / 2
+    [[nodiscard]] std::uint64_t nb_wedges() const noexcept {
+        return _nb_wedges;
+    }
+    // ratio of the wedges that are closed by a triangle
+    [[nodiscard]] double global_clustering_coefficient() const noexcept {
+        if(_nb_wedges == 0) return 0.0;
+        return 3.0 * static_cast<double>(nb_triangles()) /
+               static_cast<double>(_nb_wedges);
+    }
+
+    void run() {
+        _next_chunk.store(0, std::memory_order_relaxed);
+        _nb_triangles.store(0, std::memory_order_relaxed);
+        auto work = [this]() {
+            std::uint64_t count = 0;
+            for(;;) {
+                const std::size_t first = _next_chunk.fetch_add(
+                    chunk_size, std::memory_order_relaxed);
+                if(first >= _nb_vertices) break;
+                const std::size_t last =
+                    std::min(_nb_vertices, first + chunk_size);
+                for(std::size_t u = first; u < last; ++u) count += count_at(u);
+            }
+            _nb_triangles.fetch_add(count, std::memory_order_relaxed);
+        };
+        std::vector<std::thread> threads;
+        for(std::size_t t = 1; t < _nb_threads; ++t)
+            threads.emplace_back(work);
+        work();
+        for(auto & thread : threads) thread.join();
+    }
+
+private:
+    [[nodiscard]] std::span<const std::uint32_t> out_neighbors(
+        const std::size_t u) const noexcept {
+        return {_out_neighbors.data() + _out_begin[u],
+                _out_begin[u + 1] - _out_begin[u]};
+    }
+
+    // Renumbers the vertices by nondecreasing degree, counting the parallel
+    // arcs, orients the edges and removes their duplicates
+    void build_dag(const Graph & g) {
+        std::vector<std::size_t> degree(_nb_vertices, 0);
+        for(auto && u : g.vertices())
+            for(auto && a : g.out_arcs(u)) {
+                const auto v = g.arc_target(a);
+                if(u == v) continue;
+                ++degree[u];
+                ++degree[v];
+            }
+        std::vector<std::uint32_t> order(_nb_vertices);
+        std::iota(order.begin(), order.end(), std::uint32_t{0});
+        std::stable_sort(order.begin(), order.end(),
+                         [&degree](const std::uint32_t u,
+                                   const std::uint32_t v) {
+                             return degree[u] < degree[v];
+                         });
+        std::vector<std::uint32_t> rank(_nb_vertices);
+        for(std::size_t i = 0; i < _nb_vertices; ++i)
+            rank[order[i]] = static_cast<std::uint32_t>(i);
+
+        auto for_each_edge = [&](auto && f) {
+            for(auto && u : g.vertices())
+                for(auto && a : g.out_arcs(u)) {
+                    const auto v = g.arc_target(a);
+                    if(u == v) continue;
+                    f(std::min(rank[u], rank[v]), std::max(rank[u], rank[v]));
+                }
+        };
+        std::vector<std::size_t> begin(_nb_vertices + 1, 0);
+        for_each_edge([&begin](const std::uint32_t u, const std::uint32_t) {
+            ++begin[u + 1];
+        });
+        for(std::size_t u = 0; u < _nb_vertices; ++u) begin[u + 1] += begin[u];
+        _out_neighbors.resize(begin[_nb_vertices]);
+        std::vector<std::size_t> position(begin.begin(), begin.end() - 1);
+        for_each_edge([this, &position](const std::uint32_t u,
+                                        const std::uint32_t v) {
+            _out_neighbors[position[u]++] = v;
+        });
+
+        // sorts and deduplicates the lists in place
+        std::vector<std::uint64_t> edge_degree(_nb_vertices, 0);
+        for(std::size_t u = 0; u < _nb_vertices; ++u) {
+            const auto first = _out_neighbors.begin() +
+                               static_cast<std::ptrdiff_t>(begin[u]);
+            const auto last = _out_neighbors.begin() +
+                              static_cast<std::ptrdiff_t>(begin[u + 1]);
+            std::sort(first, last);
+            const auto unique_last = std::unique(first, last);
+            _out_begin[u + 1] =
+                _out_begin[u] + static_cast<std::size_t>(unique_last - first);
+            std::copy(first, unique_last,
+                      _out_neighbors.begin() +
+                          static_cast<std::ptrdiff_t>(_out_begin[u]));
+            for(std::size_t i = _out_begin[u]; i < _out_begin[u + 1]; ++i) {
+                ++edge_degree[u];
+                ++edge_degree[_out_neighbors[i]];
+            }
+        }
+        _out_neighbors.resize(_out_begin[_nb_vertices]);
+        _out_neighbors.shrink_to_fit();
+        for(const std::uint64_t d : edge_degree)
+            if(d > 1) _nb_wedges += d * (d - 1) / 2;
+    }
+
+    [[nodiscard]] std::uint64_t count_at(const std::size_t u) const noexcept {
+        const std::span<const std::uint32_t> u_neighbors = out_neighbors(u);
+        std::uint64_t count = 0;
+        for(std::size_t i = 0; i < u_neighbors.size(); ++i)
+            count += intersection_size(u_neighbors.subspan(i + 1),
+                                       out_neighbors(u_neighbors[i]));
+        return count;
+    }
+
+    [[nodiscard]] static std::size_t intersection_size(
+        std::span<const std::uint32_t> a,
+        std::span<const std::uint32_t> b) noexcept {
+        if(a.empty() || b.empty()) return 0;
+        if constexpr(Strategy == intersection_strategy::merge)
+            return merge_intersection_size(a, b);
+        else if constexpr(Strategy == intersection_strategy::galloping)
+            return a.size() <= b.size() ? galloping_intersection_size(a, b)
+                                        : galloping_intersection_size(b, a);
+        else
+            return simd_intersection_size(a, b);
+    }
+
+    [[nodiscard]] static std::size_t merge_intersection_size(
+        const std::span<const std::uint32_t> a,
+        const std::span<const std::uint32_t> b) noexcept {
+        std::size_t count = 0;
+        for(std::size_t i = 0, j = 0; i < a.size() && j < b.size();) {
+            count += (a[i] == b[j]);
+            const std::uint32_t a_value = a[i];
+            i += (a_value <= b[j]);
+            j += (b[j] <= a_value);
+        }
+        return count;
+    }
+
+    // searches the elements of the shorter list a in the longer list b from
+    // the position of the previous one, by doubling steps
+    [[nodiscard]] static std::size_t galloping_intersection_size(
+        const std::span<const std::uint32_t> a,
+        const std::span<const std::uint32_t> b) noexcept {
+        std::size_t count = 0;
+        std::size_t low = 0;  // b[j] < x for every j < low
+        for(const std::uint32_t x : a) {
+            std::size_t high = low;
+            for(std::size_t step = 1; high < b.size() && b[high] < x;
+                step *= 2) {
+                low = high + 1;
+                high += step;
+            }
+            low = static_cast<std::size_t>(
+                std::lower_bound(b.begin() + static_cast<std::ptrdiff_t>(low),
+                                 b.begin() + static_cast<std::ptrdiff_t>(
+                                                 std::min(high + 1, b.size())),
+                                 x) -
+                b.begin());
+            if(low == b.size()) break;
+            if(b[low] == x) {
+                ++count;
+                ++low;
+            }
+        }
+        return count;
+    }
+
+    // compares every element of a block of a to every element of a block of
+    // b, then advances the block of smaller last element, or both, and ends
+    // with a merge
+    [[nodiscard]] static std::size_t simd_intersection_size(
+        const std::span<const std::uint32_t> a,
+        const std::span<const std::uint32_t> b) noexcept {
+#if defined(__AVX2__)
+        constexpr std::size_t block = 8;
+#else
+        constexpr std::size_t block = 4;
+#endif
+        std::size_t count = 0;
+        std::size_t i = 0, j = 0;
+        while(i + block <= a.size() && j + block <= b.size()) {
+            count += block_intersection_size(a.data() + i, b.data() + j);
+            const std::uint32_t a_max = a[i + block - 1];
+            const std::uint32_t b_max = b[j + block - 1];
+            i += (a_max <= b_max) * block;
+            j += (b_max <= a_max) * block;
+        }
+        return count + merge_intersection_size(a.subspan(i), b.subspan(j));
+    }
+
+#if defined(__AVX2__)
+    [[nodiscard]] static std::size_t block_intersection_size(
+        const std::uint32_t * a, const std::uint32_t * b) noexcept {
+        const __m256i va =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b));
+        const __m256i rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+        __m256i equal = _mm256_cmpeq_epi32(va, vb);
+        for(int r = 1; r < 8; ++r) {
+            vb = _mm256_permutevar8x32_epi32(vb, rotate);
+            equal = _mm256_or_si256(equal, _mm256_cmpeq_epi32(va, vb));
+        }
+        return static_cast<std::size_t>(std::popcount(static_cast<unsigned>(
+            _mm256_movemask_ps(_mm256_castsi256_ps(equal)))));
+    }
+#elif defined(__SSE2__)
+    [[nodiscard]] static std::size_t block_intersection_size(
+        const std::uint32_t * a, const std::uint32_t * b) noexcept {
+        const __m128i va =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(a));
+        const __m128i vb =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(b));
+        const __m128i equal = _mm_or_si128(
+            _mm_or_si128(
+                _mm_cmpeq_epi32(va, vb),
+                _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0b00111001))),
+            _mm_or_si128(
+                _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0b01001110)),
+                _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0b10010011))));
+        return static_cast<std::size_t>(std::popcount(static_cast<unsigned>(
+            _mm_movemask_ps(_mm_castsi128_ps(equal)))));
+    }
+#else
+    [[nodiscard]] static std::size_t block_intersection_size(
+        const std::uint32_t * a, const std::uint32_t * b) noexcept {
+        std::size_t count = 0;
+        for(std::size_t i = 0; i < 4; ++i)
+            for(std::size_t j = 0; j < 4; ++j) count += (a[i] == b[j]);
+        return count;
+    }
+#endif
+};
+
+#endif  // TRIANGLE_COUNTING_HPP
@@ -0,0 +1,302 @@
+#ifndef WEAKLY_CONNECTED_COMPONENTS_HPP
+#define WEAKLY_CONNECTED_COMPONENTS_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <barrier>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "melon/container/static_digraph.hpp"
+
+enum class wcc_kernel : char {
+    union_find,         // sequential
+    label_propagation,  // Shiloach-Vishkin hooking and shortcutting
+    afforest            // subgraph sampling then skipping (Sutton et al.)
+};
+
+/**
+ * @brief Weakly connected components, labelled by their smallest vertex.
+ *
+ * The arcs are copied in a CSR and seen as edges. Every kernel maintains a
+ * forest whose roots are the smallest vertices of their trees, a root being
+ * only ever hooked under a smaller one:
+ * - union_find processes the arcs sequentially, halving the paths of the
+ *   finds;
+ * - label_propagation hooks, for every arc, the larger of the two parents
+ *   of its ends under the smaller one if it is a root, then shortcuts every
+ *   vertex to its root, until no hook occurs;
+ * - afforest links the first neighbor_rounds out neighbors of every vertex,
+ *   which mostly builds the giant component, samples the most frequent
+ *   root, then links the remaining arcs of the vertices outside of it. The
+ *   arcs entering these vertices are also linked, from a transpose CSR,
+ *   since the vertices of the giant component are skipped.
+ * The parallel kernels take chunks of vertices from an atomic counter and
+ * update the parents by atomic operations.
+ */
+template <typename Graph, wcc_kernel Kernel>
+class weakly_connected_components {
+public:
+    using vertex = fhamonic::melon::vertex_t<Graph>;
+
+private:
+    static constexpr std::size_t chunk_size = 1024;
+    static constexpr std::size_t neighbor_rounds = 2;
+    static constexpr std::size_t nb_samples = 1024;
+
+    std::size_t _nb_vertices;
+    std::size_t _nb_threads;
+    std::vector<std::size_t> _out_begin;
+    std::vector<std::uint32_t> _out_neighbors;
+    std::vector<std::size_t> _in_begin;         // afforest only
+    std::vector<std::uint32_t> _in_neighbors;   // afforest only
+    std::vector<std::uint32_t> _parent_map;
+    std::atomic<std::size_t> _next_chunk;
+    std::atomic<bool> _changed;
+    std::uint32_t _sampled_root;  // afforest only
+
+public:
+    [[nodiscard]] explicit weakly_connected_components(
+        const Graph & g, const std::size_t nb_threads = 1)
+        : _nb_vertices(g.nb_vertices())
+        , _nb_threads(Kernel == wcc_kernel::union_find
+                          ? 1
+                          : std::max(nb_threads, std::size_t{1}))
+        , _out_begin(g.nb_vertices() + 1, 0)
+        , _out_neighbors(g.nb_arcs())
+        , _parent_map(g.nb_vertices())
+        , _next_chunk(0)
+        , _changed(false)
+        , _sampled_root(0) {
+        for(auto && u : g.vertices()) {
+            _out_begin[u + 1] = _out_begin[u];
+            for(auto && a : g.out_arcs(u))
+                _out_neighbors[_out_begin[u + 1]++] =
+                    static_cast<std::uint32_t>(g.arc_target(a));
+        }
+        if constexpr(Kernel == wcc_kernel::afforest) build_in_arcs();
+    }
+
+    [[nodiscard]] std::size_t nb_threads() const noexcept {
+        return _nb_threads;
+    }
+    // smallest vertex of the component of u
+    [[nodiscard]] vertex component(const vertex u) const noexcept {
+        return static_cast<vertex>(_parent_map[u]);
+    }
+    [[nodiscard]] std::span<const std::uint32_t> labels() const noexcept {
+        return _parent_map;
+    }
+    [[nodiscard]] std::size_t nb_components() const noexcept {
+        std::size_t count = 0;
+        for(std::size_t u = 0; u < _nb_vertices; ++u)
+            count += (_parent_map[u] == u);
+        return count;
+    }
+
+    void run() {
+        if(_nb_vertices == 0) return;
+        if constexpr(Kernel == wcc_kernel::union_find)
+            union_find();
+        else if constexpr(Kernel == wcc_kernel::label_propagation)
+            run_threads([this](auto & sync, auto &) {
+                label_propagation(sync);
+            });
+        else
+            run_threads([this](auto & sync, auto & sync_sample) {
+                afforest(sync, sync_sample);
+            });
+    }
+
+private:
+    void build_in_arcs() {
+        _in_begin.assign(_nb_vertices + 1, 0);
+        _in_neighbors.resize(_out_neighbors.size());
+        for(const std::uint32_t v : _out_neighbors) ++_in_begin[v + 1];
+        for(std::size_t v = 0; v < _nb_vertices; ++v)
+            _in_begin[v + 1] += _in_begin[v];
+        std::vector<std::size_t> in_position(_in_begin.begin(),
+                                             _in_begin.end() - 1);
+        for(std::size_t u = 0; u < _nb_vertices; ++u)
+            for(std::size_t i = _out_begin[u]; i < _out_begin[u + 1]; ++i)
+                _in_neighbors[in_position[_out_neighbors[i]]++] =
+                    static_cast<std::uint32_t>(u);
+    }
+
+    void union_find() {
+        for(std::size_t u = 0; u < _nb_vertices; ++u)
+            _parent_map[u] = static_cast<std::uint32_t>(u);
+        auto find = [this](std::uint32_t u) {
+            while(_parent_map[u] != u) {
+                _parent_map[u] = _parent_map[_parent_map[u]];
+                u = _parent_map[u];
+            }
+            return u;
+        };
+        for(std::size_t u = 0; u < _nb_vertices; ++u) {
+            for(std::size_t i = _out_begin[u]; i < _out_begin[u + 1]; ++i) {
+                const std::uint32_t u_root =
+                    find(static_cast<std::uint32_t>(u));
+                const std::uint32_t v_root = find(_out_neighbors[i]);
+                if(u_root < v_root)
+                    _parent_map[v_root] = u_root;
+                else
+                    _parent_map[u_root] = v_root;
+            }
+        }
+        for(std::size_t u = 0; u < _nb_vertices; ++u)
+            _parent_map[u] = _parent_map[_parent_map[u]];
+    }
+
+    // Runs work(sync, sync_sample) on every thread, sync resetting the
+    // chunk counter and sync_sample also sampling the most frequent root
+    template <typename Work>
+    void run_threads(Work && work) {
+        auto reset_chunks = [this]() noexcept {
+            _next_chunk.store(0, std::memory_order_relaxed);
+        };
+        std::barrier sync(static_cast<std::ptrdiff_t>(_nb_threads),
+                          reset_chunks);
+        std::barrier sync_sample(static_cast<std::ptrdiff_t>(_nb_threads),
+                                 [this]() noexcept {
+                                     _next_chunk.store(
+                                         0, std::memory_order_relaxed);
+                                     _sampled_root = most_frequent_root();
+                                 });
+        std::vector<std::thread> threads;
+        for(std::size_t t = 1; t < _nb_threads; ++t)
+            threads.emplace_back([&]() { work(sync, sync_sample); });
+        work(sync, sync_sample);
+        for(auto & thread : threads) thread.join();
+    }
+    template <typename F>
+    void for_each_chunk(F && f) {
+        for(;;) {
+            const std::size_t first =
+                _next_chunk.fetch_add(chunk_size, std::memory_order_relaxed);
+            if(first >= _nb_vertices) break;
+            const std::size_t last = std::min(_nb_vertices, first + chunk_size);
+            for(std::size_t u = first; u < last; ++u) f(u);
+        }
+    }
+
+    [[nodiscard]] std::uint32_t load(const std::size_t u) noexcept {
+        return std::atomic_ref<std::uint32_t>(_parent_map[u]).load(
+            std::memory_order_relaxed);
+    }
+    void store(const std::size_t u, const std::uint32_t p) noexcept {
+        std::atomic_ref<std::uint32_t>(_parent_map[u]).store(
+            p, std::memory_order_relaxed);
+    }
+    void init_parents(auto & sync) {
+        for_each_chunk([this](std::size_t u) {
+            store(u, static_cast<std::uint32_t>(u));
+        });
+        sync.arrive_and_wait();
+    }
+    void compress(auto & sync) {
+        for_each_chunk([this](std::size_t u) {
+            for(std::uint32_t p = load(u), gp = load(p); p != gp;
+                p = gp, gp = load(p))
+                store(u, gp);
+        });
+        sync.arrive_and_wait();
+    }
+
+    void label_propagation(auto & sync) {
+        init_parents(sync);
+        for(;;) {
+            for_each_chunk([this](std::size_t u) {
+                for(std::size_t i = _out_begin[u]; i < _out_begin[u + 1];
+                    ++i) {
+                    const std::uint32_t p = load(u);
+                    const std::uint32_t q = load(_out_neighbors[i]);
+                    if(p == q) continue;
+                    std::uint32_t high = std::max(p, q);
+                    const std::uint32_t low = std::min(p, q);
+                    // hooks high under low if high is still a root
+                    if(std::atomic_ref<std::uint32_t>(_parent_map[high])
+                           .compare_exchange_strong(
+                               high, low, std::memory_order_relaxed))
+                        _changed.store(true, std::memory_order_relaxed);
+                }
+            });
+            sync.arrive_and_wait();
+            compress(sync);
+            if(!_changed.load(std::memory_order_relaxed)) break;
+            sync.arrive_and_wait();  // every thread read _changed
+            _changed.store(false, std::memory_order_relaxed);
+            sync.arrive_and_wait();
+        }
+    }
+
+    // Links the trees of u and v by hooking the larger root under the other
+    void link(std::uint32_t u, std::uint32_t v) noexcept {
+        std::uint32_t p = load(u);
+        std::uint32_t q = load(v);
+        while(p != q) {
+            const std::uint32_t high = std::max(p, q);
+            const std::uint32_t low = std::min(p, q);
+            std::uint32_t high_parent = load(high);
+            if(high_parent == low) break;
+            if(high_parent == high &&
+               std::atomic_ref<std::uint32_t>(_parent_map[high])
+                   .compare_exchange_strong(high_parent, low,
+                                            std::memory_order_relaxed))
+                break;
+            p = load(load(high));
+            q = load(low);
+        }
+    }
+
+    void afforest(auto & sync, auto & sync_sample) {
+        init_parents(sync);
+        for(std::size_t r = 0; r < neighbor_rounds; ++r) {
+            for_each_chunk([this, r](std::size_t u) {
+                if(_out_begin[u] + r < _out_begin[u + 1])
+                    link(static_cast<std::uint32_t>(u),
+                         _out_neighbors[_out_begin[u] + r]);
+            });
+            sync.arrive_and_wait();
+            compress(sync);
+        }
+        sync_sample.arrive_and_wait();
+        for_each_chunk([this](std::size_t u) {
+            if(load(u) == _sampled_root) return;
+            const auto w = static_cast<std::uint32_t>(u);
+            for(std::size_t i = _out_begin[u] + neighbor_rounds;
+                i < _out_begin[u + 1]; ++i)
+                link(w, _out_neighbors[i]);
+            for(std::size_t i = _in_begin[u]; i < _in_begin[u + 1]; ++i)
+                link(w, _in_neighbors[i]);
+        });
+        sync.arrive_and_wait();
+        compress(sync);
+    }
+    // barrier completion step, run by a single thread, hence without
+    // allocation
+    [[nodiscard]] std::uint32_t most_frequent_root() const noexcept {
+        std::mt19937 rng(1234);
+        std::uniform_int_distribution<std::size_t> pick(0, _nb_vertices - 1);
+        std::array<std::uint32_t, nb_samples> samples;
+        for(auto & s : samples) s = _parent_map[pick(rng)];
+        std::sort(samples.begin(), samples.end());
+        std::uint32_t best = samples[0];
+        std::size_t best_count = 0;
+        for(std::size_t i = 0, j = 0; i < samples.size(); i = j) {
+            while(j < samples.size() && samples[j] == samples[i]) ++j;
+            if(j - i > best_count) {
+                best = samples[i];
+                best_count = j - i;
+            }
+        }
+        return best;
+    }
+};
+
+#endif  // WEAKLY_CONNECTED_COMPONENTS_HPP
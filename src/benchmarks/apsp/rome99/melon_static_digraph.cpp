@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "melon/algorithm/dijkstra.hpp"
+#include "melon/container/static_digraph.hpp"
+
+#include "chrono.hpp"
+#include "floyd_warshall.hpp"
+#include "melon_parsers.hpp"
+#include "warm_up.hpp"
+
+using namespace fhamonic::melon;
+
+// One dijkstra per source, the sources being distributed to the threads
+template <typename LengthMap>
+void dijkstra_apsp(const static_digraph & graph, const LengthMap & length_map,
+                   std::vector<double> & matrix,
+                   const std::size_t nb_threads) {
+    const std::size_t n = graph.nb_vertices();
+    std::fill(matrix.begin(), matrix.end(),
+              floyd_warshall<double>::infinity);
+    std::atomic<std::size_t> next_source = 0;
+    auto work = [&]() {
+        for(;;) {
+            const std::size_t s =
+                next_source.fetch_add(1, std::memory_order_relaxed);
+            if(s >= n) break;
+            double * const row = matrix.data() + s * n;
+            const auto source = static_cast<vertex_t<static_digraph>>(s);
+            for(auto && [u, dist] : dijkstra(graph, length_map, source))
+                row[u] = dist;
+        }
+    };
+    std::vector<std::thread> threads;
+    for(std::size_t t = 1; t < nb_threads; ++t) threads.emplace_back(work);
+    work();
+    for(auto & thread : threads) thread.join();
+}
+
+int main() {
+    const std::filesystem::path gr_file = "data/rome99.gr";
+    const std::vector<std::size_t> nb_threads_list = {1, 2, 4, 8, 16};
+    const std::filesystem::path matrix_file = "rome99_apsp.bin";
+
+    std::cout << "instance,nb_nodes,nb_arcs,algorithm,nb_threads,time_ms,"
+                 "memory_mb,identical_distances\n";
+
+    (void)warm_up();
+
+    auto [graph, length_map] =
+        parse_melon_weighted_digraph<static_digraph, double>(gr_file);
+    const std::size_t n = graph.nb_vertices();
+
+    // sequential dijkstra runs give the reference matrix
+    std::vector<double> reference(n * n);
+    std::vector<double> matrix(n * n);
+    auto print = [&](const std::string & algorithm,
+                     const std::size_t nb_threads, const double time,
+                     const std::size_t memory_bytes, const bool identical) {
+        std::cout << gr_file.stem() << ',' << n << ',' << graph.nb_arcs()
+                  << ',' << algorithm << ',' << nb_threads << ',' << time
+                  << ',' << double(memory_bytes) / (1 << 20) << ','
+                  << identical << std::endl;
+    };
+
+    for(const std::size_t nb_threads : nb_threads_list) {
+        Chrono chrono;
+        dijkstra_apsp(graph, length_map,
+                      nb_threads == 1 ? reference : matrix, nb_threads);
+        const double time = chrono.timeUs() / 1000.0;
+        print("dijkstra", nb_threads, time, n * n * sizeof(double),
+              nb_threads == 1 || matrix == reference);
+    }
+
+    auto check = [&](const auto & fw) {
+        for(std::size_t u = 0; u < n; ++u)
+            for(std::size_t v = 0; v < n; ++v)
+                if(static_cast<double>(fw.dist(u, v)) != reference[u * n + v])
+                    return false;
+        return true;
+    };
+    for(const std::size_t nb_threads : nb_threads_list) {
+        floyd_warshall<double> fw(graph, length_map);
+        Chrono chrono;
+        fw.run(nb_threads);
+        const double time = chrono.timeUs() / 1000.0;
+        print("floyd_warshall_double", nb_threads, time, fw.memory_bytes(),
+              check(fw));
+        if(nb_threads == 1) {
+            std::ofstream os(matrix_file, std::ios::binary);
+            fw.write_binary(os);
+        }
+    }
+    // road distances are integers small enough to be exact in floats
+    for(const std::size_t nb_threads : nb_threads_list) {
+        floyd_warshall<float> fw(graph, length_map);
+        Chrono chrono;
+        fw.run(nb_threads);
+        const double time = chrono.timeUs() / 1000.0;
+        print("floyd_warshall_float", nb_threads, time, fw.memory_bytes(),
+              check(fw));
+    }
+    return 0;
+}
@@ -0,0 +1,95 @@
+#include <array>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <type_traits>
+
+#include "melon/algorithm/dijkstra.hpp"
+#include "melon/container/static_digraph.hpp"
+
+#include "batched_dijkstra.hpp"
+#include "chrono.hpp"
+#include "melon_parsers.hpp"
+#include "warm_up.hpp"
+
+using namespace fhamonic::melon;
+
+template <std::size_t K>
+void benchmark_batches(const std::filesystem::path & gr_file,
+                       const static_digraph & graph,
+                       const std::vector<double> & length_map) {
+    const int nb_nodes = graph.nb_vertices();
+    const int nb_batches = 3000.0 * 1000.0 / nb_nodes / K + 1;
+
+    batched_dijkstra<static_digraph, std::vector<double>, K> algo(graph,
+                                                                  length_map);
+    double avg_batch_time = 0;
+    double avg_dijkstra_time = 0;
+    double avg_scans = 0;
+    bool identical = true;
+    std::vector<double> distances(nb_nodes);
+    vertex_t<static_digraph> s = 0;
+    for(int batch = 0; batch < nb_batches; ++batch) {
+        std::array<vertex_t<static_digraph>, K> sources;
+        for(auto & source : sources) source = s++ % nb_nodes;
+
+        Chrono chrono;
+        algo.run(sources);
+        avg_batch_time += (chrono.timeUs() / 1000.0);
+        avg_scans += static_cast<double>(algo.nb_scans());
+
+        for(std::size_t i = 0; i < K; ++i) {
+            std::fill(distances.begin(), distances.end(),
+                      std::numeric_limits<double>::max());
+            Chrono dijkstra_chrono;
+            for(auto && [u, dist] : dijkstra(graph, length_map, sources[i])) {
+                distances[u] = dist;
+            }
+            avg_dijkstra_time += (dijkstra_chrono.timeUs() / 1000.0);
+
+            for(auto && u : graph.vertices())
+                identical &= (algo.dist(i, u) == distances[u]);
+        }
+    }
+    avg_batch_time /= nb_batches;
+    avg_dijkstra_time /= nb_batches * K;
+    avg_scans /= nb_batches;
+
+    std::cout << gr_file.stem() << ',' << nb_nodes << ',' << graph.nb_arcs()
+              << ',' << K << ',' << avg_batch_time << ','
+              << avg_batch_time / K << ',' << avg_dijkstra_time << ','
+              << avg_dijkstra_time * K / avg_batch_time << ','
+              << avg_scans / nb_nodes << ',' << identical << std::endl;
+}
+
+int main() {
+    std::vector<std::filesystem::path> gr_files(
+        {"data/9th_DIMACS_USA_roads/distance/USA-road-d.NY.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NY.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.BAY.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.BAY.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.COL.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.COL.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.FLA.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.FLA.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.NW.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NW.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.NE.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NE.gr"});
+
+    std::cout << "instance,nb_nodes,nb_arcs,nb_sources,batch_time_ms,"
+                 "time_per_source_ms,dijkstra_time_per_source_ms,speedup,"
+                 "scans_per_vertex,identical_distances\n";
+
+    (void)warm_up();
+
+    for(const auto & gr_file : gr_files) {
+        auto [graph, length_map] =
+            parse_melon_weighted_digraph<static_digraph, double>(gr_file);
+
+        benchmark_batches<4>(gr_file, graph, length_map);
+        benchmark_batches<8>(gr_file, graph, length_map);
+        benchmark_batches<16>(gr_file, graph, length_map);
+    }
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "melon/container/static_digraph.hpp"
+
+#include "betweenness_centrality.hpp"
+#include "chrono.hpp"
+#include "melon_parsers.hpp"
+#include "warm_up.hpp"
+
+using namespace fhamonic::melon;
+
+int main() {
+    const std::filesystem::path gr_file = "data/rome99.gr";
+    const std::vector<std::size_t> nb_sources_list = {32, 128, 512};
+    const std::vector<std::size_t> nb_threads_list = {1, 2, 4, 8, 16};
+
+    std::cout << "instance,nb_nodes,nb_arcs,nb_sources,nb_threads,time_ms,"
+                 "parallel_speedup,sampling_speedup,relative_l1_error\n";
+
+    (void)warm_up();
+
+    auto [graph, length_map] =
+        parse_melon_weighted_digraph<static_digraph, double>(gr_file);
+    const std::size_t n = graph.nb_vertices();
+
+    // exact centralities of the sequential run are the reference, the
+    // thread sweep rows only have a parallel speedup and the sampled rows
+    // only a sampling speedup, both relative to the sequential exact run
+    std::vector<double> reference(n);
+    double reference_sum = 0.0;
+    double sequential_time = 0.0;
+    auto print = [&](const auto & bc, const std::size_t nb_sources,
+                     const std::size_t nb_threads, const double time_ms,
+                     const bool sampled) {
+        double error = 0.0;
+        for(auto && u : graph.vertices())
+            error += std::abs(bc.centrality(u) - reference[u]);
+        const double speedup = sequential_time / time_ms;
+        std::cout << gr_file.stem() << ',' << n << ',' << graph.nb_arcs()
+                  << ',' << nb_sources << ',' << nb_threads << ',' << time_ms
+                  << ',';
+        if(!sampled) std::cout << speedup;
+        std::cout << ',';
+        if(sampled) std::cout << speedup;
+        std::cout << ',' << error / reference_sum << std::endl;
+    };
+
+    for(const std::size_t nb_threads : nb_threads_list) {
+        betweenness_centrality<static_digraph, decltype(length_map),
+                               length_class::general>
+            bc(graph, length_map, nb_threads);
+        Chrono chrono;
+        bc.run();
+        const double time_ms = chrono.timeUs() / 1000.0;
+        if(nb_threads == 1) {
+            sequential_time = time_ms;
+            for(auto && u : graph.vertices()) {
+                reference[u] = bc.centrality(u);
+                reference_sum += reference[u];
+            }
+        }
+        print(bc, n, nb_threads, time_ms, false);
+    }
+
+    // sampled estimates, sequentially
+    std::vector<vertex_t<static_digraph>> vertices(n);
+    std::iota(vertices.begin(), vertices.end(), 0);
+    std::shuffle(vertices.begin(), vertices.end(), std::mt19937(1234));
+    betweenness_centrality<static_digraph, decltype(length_map),
+                           length_class::general>
+        bc(graph, length_map, 1);
+    for(const std::size_t nb_sources : nb_sources_list) {
+        const std::span<const vertex_t<static_digraph>> sources(
+            vertices.data(), std::min(nb_sources, n));
+        Chrono chrono;
+        bc.run(sources);
+        print(bc, sources.size(), 1, chrono.timeUs() / 1000.0, true);
+    }
+    return 0;
+}
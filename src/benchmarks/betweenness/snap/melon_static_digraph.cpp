@@ -0,0 +1,88 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <span>
+#include <sstream>
+#include <vector>
+
+#include "chrono.hpp"
+
+#include "melon/container/static_digraph.hpp"
+#include "melon/utility/static_digraph_builder.hpp"
+
+#include "betweenness_centrality.hpp"
+#include "warm_up.hpp"
+
+using namespace fhamonic::melon;
+
+auto parse_gr(const std::filesystem::path & file_name) {
+    std::ifstream gr_file(file_name);
+    std::size_t nb_nodes, nb_arcs;
+    gr_file >> nb_nodes >> nb_arcs;
+
+    static_digraph_builder<static_digraph> builder(nb_nodes);
+
+    vertex_t<static_digraph> from, to;
+    while(gr_file >> from >> to) builder.add_arc(from, to);
+
+    return builder.build();
+}
+
+struct unit_length_map {
+    int operator[](const arc_t<static_digraph> &) const noexcept { return 1; }
+};
+
+int main() {
+    std::vector<std::filesystem::path> gr_files(
+        {"data/web-Stanford.txt", "data/Amazon0505.txt", "data/WikiTalk.txt"});
+    const std::vector<std::size_t> nb_sources_list = {64, 256, 1024};
+    const std::vector<std::size_t> nb_threads_list = {1, 2, 4, 8, 16};
+
+    std::cout << "instance,nb_nodes,nb_arcs,nb_sources,nb_threads,time_ms,"
+                 "ms_per_source,speedup,max_centrality\n";
+
+    (void)warm_up();
+
+    for(const auto & gr_file : gr_files) {
+        auto [graph] = parse_gr(gr_file);
+        const int nb_nodes = graph.nb_vertices();
+
+        // nested samples of uniformly drawn sources
+        std::vector<vertex_t<static_digraph>> vertices(graph.nb_vertices());
+        std::iota(vertices.begin(), vertices.end(), 0);
+        std::shuffle(vertices.begin(), vertices.end(), std::mt19937(1234));
+
+        std::vector<double> sequential_times(nb_sources_list.size());
+        for(const std::size_t nb_threads : nb_threads_list) {
+            // the per-thread arrays are allocated once for all the samples
+            betweenness_centrality<static_digraph, unit_length_map,
+                                   length_class::uniform>
+                bc(graph, unit_length_map{}, nb_threads);
+            for(std::size_t j = 0; j < nb_sources_list.size(); ++j) {
+                const std::span<const vertex_t<static_digraph>> sources(
+                    vertices.data(),
+                    std::min(nb_sources_list[j], vertices.size()));
+
+                Chrono chrono;
+                bc.run(sources);
+                const double time_ms = chrono.timeUs() / 1000.0;
+                if(nb_threads == 1) sequential_times[j] = time_ms;
+
+                double max_centrality = 0.0;
+                for(auto && u : graph.vertices())
+                    max_centrality = std::max(max_centrality, bc.centrality(u));
+
+                std::cout << gr_file.stem() << ',' << nb_nodes << ','
+                          << graph.nb_arcs() << ',' << sources.size() << ','
+                          << nb_threads << ',' << time_ms << ','
+                          << time_ms / static_cast<double>(sources.size())
+                          << ',' << sequential_times[j] / time_ms << ','
+                          << max_centrality << std::endl;
+            }
+        }
+    }
+    return 0;
+}
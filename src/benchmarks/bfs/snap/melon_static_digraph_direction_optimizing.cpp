@@ -0,0 +1,101 @@
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "chrono.hpp"
+
+#include "melon/container/static_digraph.hpp"
+#include "melon/utility/static_digraph_builder.hpp"
+
+#include "direction_optimizing_bfs.hpp"
+#include "warm_up.hpp"
+
+using namespace fhamonic::melon;
+
+auto parse_gr(const std::filesystem::path & file_name) {
+    std::ifstream gr_file(file_name);
+    std::size_t nb_nodes, nb_arcs;
+    gr_file >> nb_nodes >> nb_arcs;
+
+    static_digraph_builder<static_digraph> builder(nb_nodes);
+
+    vertex_t<static_digraph> from, to;
+    while(gr_file >> from >> to) builder.add_arc(from, to);
+
+    return builder.build();
+}
+
+// BFS levels are valid if no arc skips a level forward and every reached
+// vertex but s has an in-neighbor one level above
+bool valid_levels(const static_digraph & graph,
+                  const direction_optimizing_bfs<static_digraph> & bfs,
+                  const vertex_t<static_digraph> s) {
+    std::vector<char> has_parent(graph.nb_vertices(), false);
+    has_parent[s] = true;
+    for(auto && u : graph.vertices()) {
+        if(!bfs.reached(u)) continue;
+        for(auto && a : graph.out_arcs(u)) {
+            const auto v = graph.arc_target(a);
+            if(!bfs.reached(v) || bfs.level(v) > bfs.level(u) + 1)
+                return false;
+            if(bfs.level(v) == bfs.level(u) + 1) has_parent[v] = true;
+        }
+    }
+    for(auto && u : graph.vertices())
+        if(bfs.reached(u) && !has_parent[u]) return false;
+    return bfs.level(s) == 0;
+}
+
+int main() {
+    std::vector<std::filesystem::path> gr_files(
+        {"data/web-Stanford.txt", "data/Amazon0505.txt", "data/WikiTalk.txt"});
+
+    std::cout << "instance,nb_nodes,nb_arcs,time_ms,transpose_time_ms,"
+                 "examined_arcs,top_down_examined_arcs,bottom_up_steps,"
+                 "valid_levels\n";
+
+    (void)warm_up();
+
+    for(const auto & gr_file : gr_files) {
+        auto [graph] = parse_gr(gr_file);
+
+        Chrono transpose_chrono;
+        direction_optimizing_bfs bfs(graph);
+        const double transpose_time = transpose_chrono.timeUs() / 1000.0;
+
+        double avg_time = 0;
+        double avg_examined_arcs = 0;
+        double avg_top_down_arcs = 0;
+        double avg_bottom_up_steps = 0;
+        bool valid = true;
+        int iterations = 0;
+        const int nb_nodes = graph.nb_vertices();
+        const int nb_iterations = int(30000.0 * 1000.0 / nb_nodes);
+        for(auto && s : graph.vertices()) {
+            Chrono chrono;
+            bfs.run(s);
+            double time_ms = (chrono.timeUs() / 1000.0);
+            avg_time += time_ms;
+
+            avg_examined_arcs += double(bfs.nb_examined_arcs());
+            avg_bottom_up_steps += double(bfs.nb_bottom_up_steps());
+            // a top-down BFS examines the out arcs of every reached vertex
+            for(auto && u : graph.vertices())
+                if(bfs.reached(u))
+                    avg_top_down_arcs += double(graph.out_arcs(u).size());
+            valid &= valid_levels(graph, bfs, s);
+            ++iterations;
+            if(iterations >= nb_iterations) break;
+        }
+        avg_time /= iterations;
+
+        std::cout << gr_file.stem() << ',' << nb_nodes << ',' << graph.nb_arcs()
+                  << ',' << avg_time << ',' << transpose_time << ','
+                  << avg_examined_arcs / iterations << ','
+                  << avg_top_down_arcs / iterations << ','
+                  << avg_bottom_up_steps / iterations << ',' << valid
+                  << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <type_traits>
+
+#include "melon/algorithm/dijkstra.hpp"
+#include "melon/container/static_digraph.hpp"
+
+#include "chrono.hpp"
+#include "delta_stepping.hpp"
+#include "melon_parsers.hpp"
+#include "warm_up.hpp"
+
+using namespace fhamonic::melon;
+
+int main() {
+    std::vector<std::filesystem::path> gr_files(
+        {"data/9th_DIMACS_USA_roads/distance/USA-road-d.NY.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NY.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.BAY.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.BAY.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.COL.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.COL.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.FLA.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.FLA.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.NW.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NW.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.NE.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NE.gr"});
+    // delta is swept as a multiple of the average arc length
+    std::vector<double> delta_factors({1.0, 4.0, 16.0, 64.0});
+    std::vector<std::size_t> threads_counts({1, 2, 4, 8, 16});
+
+    std::cout << "instance,nb_nodes,nb_arcs,delta,nb_threads,time_ms,"
+                 "dijkstra_time_ms,speedup,identical_distances\n";
+
+    (void)warm_up();
+
+    for(const auto & gr_file : gr_files) {
+        auto [graph, length_map] =
+            parse_melon_weighted_digraph<static_digraph, double>(gr_file);
+
+        const int nb_nodes = graph.nb_vertices();
+        const int nb_iterations = 3000.0 * 1000.0 / nb_nodes;
+        std::vector<vertex_t<static_digraph>> sources;
+        for(auto && s : graph.vertices()) {
+            sources.push_back(s);
+            if(static_cast<int>(sources.size()) >= nb_iterations) break;
+        }
+
+        std::vector<std::vector<double>> dijkstra_distances;
+        double dijkstra_avg_time = 0;
+        for(auto && s : sources) {
+            Chrono chrono;
+
+            std::vector<double> distances(
+                nb_nodes, std::numeric_limits<double>::max());
+            for(auto && [u, dist] : dijkstra(graph, length_map, s)) {
+                distances[u] = dist;
+            }
+
+            dijkstra_avg_time += (chrono.timeUs() / 1000.0);
+            dijkstra_distances.emplace_back(std::move(distances));
+        }
+        dijkstra_avg_time /= static_cast<double>(sources.size());
+
+        double avg_length = 0;
+        for(auto && a : graph.arcs()) avg_length += length_map[a];
+        avg_length /= static_cast<double>(graph.nb_arcs());
+
+        for(const double delta_factor : delta_factors) {
+            for(const std::size_t nb_threads : threads_counts) {
+                delta_stepping algo(graph, length_map,
+                                    delta_factor * avg_length, nb_threads);
+
+                double avg_time = 0;
+                bool identical = true;
+                for(std::size_t i = 0; i < sources.size(); ++i) {
+                    Chrono chrono;
+                    algo.run(sources[i]);
+                    avg_time += (chrono.timeUs() / 1000.0);
+
+                    for(auto && u : graph.vertices())
+                        identical &= (algo.dist(u) == dijkstra_distances[i][u]);
+                }
+                avg_time /= static_cast<double>(sources.size());
+
+                std::cout << gr_file.stem() << ',' << nb_nodes << ','
+                          << graph.nb_arcs() << ',' << algo.delta() << ','
+                          << nb_threads << ',' << avg_time << ','
+                          << dijkstra_avg_time << ','
+                          << dijkstra_avg_time / avg_time << ','
+                          << identical << std::endl;
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+#include "melon/container/static_digraph.hpp"
+#include "melon/utility/static_digraph_builder.hpp"
+
+#include "chrono.hpp"
+#include "graph_diameter.hpp"
+#include "melon_parsers.hpp"
+#include "warm_up.hpp"
+
+using namespace fhamonic::melon;
+
+// Symmetric closure of the graph, keeping the shortest of parallel arcs
+template <typename Graph, typename LengthMap>
+auto symmetrize(const Graph & graph, const LengthMap & length_map) {
+    std::vector<std::tuple<vertex_t<Graph>, vertex_t<Graph>, double>> arcs;
+    arcs.reserve(2 * graph.nb_arcs());
+    for(auto && u : graph.vertices()) {
+        for(auto && a : graph.out_arcs(u)) {
+            const auto v = graph.arc_target(a);
+            if(u == v) continue;
+            arcs.emplace_back(u, v, length_map[a]);
+            arcs.emplace_back(v, u, length_map[a]);
+        }
+    }
+    std::sort(arcs.begin(), arcs.end());
+    arcs.erase(std::unique(arcs.begin(), arcs.end(),
+                           [](const auto & a, const auto & b) {
+                               return std::get<0>(a) == std::get<0>(b) &&
+                                      std::get<1>(a) == std::get<1>(b);
+                           }),
+               arcs.end());
+
+    static_digraph_builder<static_digraph, double> builder(
+        graph.nb_vertices());
+    for(auto && [u, v, length] : arcs) builder.add_arc(u, v, length);
+    return builder.build();
+}
+
+int main() {
+    std::vector<std::filesystem::path> gr_files(
+        {"data/9th_DIMACS_USA_roads/distance/USA-road-d.NY.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NY.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.BAY.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.BAY.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.COL.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.COL.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.FLA.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.FLA.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.NW.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NW.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.NE.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NE.gr"});
+
+    std::cout << "instance,nb_nodes,nb_arcs,component_size,algorithm,"
+                 "diameter,radius,nb_searches,time_ms\n";
+
+    (void)warm_up();
+
+    for(const auto & gr_file : gr_files) {
+        auto [directed_graph, directed_length_map] =
+            parse_melon_weighted_digraph<static_digraph, double>(gr_file);
+        auto [graph, length_map] =
+            symmetrize(directed_graph, directed_length_map);
+        const int nb_nodes = graph.nb_vertices();
+
+        graph_diameter<static_digraph, decltype(length_map),
+                       length_class::general>
+            diameter(graph, length_map);
+
+        // the diameter column of double_sweep holds a lower bound
+        auto print_row = [&](const char * algorithm, const double d,
+                             const std::optional<double> r,
+                             const double time_ms) {
+            std::cout << gr_file.stem() << ',' << nb_nodes << ','
+                      << graph.nb_arcs() << ',' << diameter.component_size()
+                      << ',' << algorithm << ',' << d << ',';
+            if(r.has_value()) std::cout << r.value();
+            std::cout << ',' << diameter.nb_searches() << ',' << time_ms
+                      << std::endl;
+        };
+
+        {
+            Chrono chrono;
+            const double lower_bound = diameter.double_sweep(0);
+            print_row("double_sweep", lower_bound, std::nullopt,
+                      chrono.timeUs() / 1000.0);
+        }
+        {
+            Chrono chrono;
+            const double d = diameter.ifub(0);
+            print_row("ifub", d, std::nullopt, chrono.timeUs() / 1000.0);
+        }
+        {
+            Chrono chrono;
+            const auto [d, r] = diameter.bounding_diameters(0);
+            print_row("bounding_diameters", d, r, chrono.timeUs() / 1000.0);
+        }
+    }
+    return 0;
+}
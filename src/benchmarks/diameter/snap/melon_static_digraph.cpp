@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <ranges>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include "chrono.hpp"
+
+#include "melon/container/static_digraph.hpp"
+#include "melon/utility/static_digraph_builder.hpp"
+
+#include "graph_diameter.hpp"
+#include "warm_up.hpp"
+
+using namespace fhamonic::melon;
+
+// Symmetric closure of the graph, without self loops nor parallel arcs
+auto parse_undirected_gr(const std::filesystem::path & file_name) {
+    std::ifstream gr_file(file_name);
+    std::size_t nb_nodes, nb_arcs;
+    gr_file >> nb_nodes >> nb_arcs;
+
+    std::vector<std::pair<vertex_t<static_digraph>, vertex_t<static_digraph>>>
+        arcs;
+    arcs.reserve(2 * nb_arcs);
+    vertex_t<static_digraph> from, to;
+    while(gr_file >> from >> to) {
+        if(from == to) continue;
+        arcs.emplace_back(from, to);
+        arcs.emplace_back(to, from);
+    }
+    std::sort(arcs.begin(), arcs.end());
+    arcs.erase(std::unique(arcs.begin(), arcs.end()), arcs.end());
+
+    static_digraph_builder<static_digraph> builder(nb_nodes);
+    for(auto && [u, v] : arcs) builder.add_arc(u, v);
+    return builder.build();
+}
+
+struct unit_length_map {
+    int operator[](const arc_t<static_digraph> &) const noexcept { return 1; }
+};
+
+int main() {
+    std::vector<std::filesystem::path> gr_files(
+        {"data/web-Stanford.txt", "data/Amazon0505.txt", "data/WikiTalk.txt"});
+
+    std::cout << "instance,nb_nodes,nb_arcs,component_size,algorithm,"
+                 "diameter,radius,nb_searches,time_ms\n";
+
+    (void)warm_up();
+
+    for(const auto & gr_file : gr_files) {
+        auto [graph] = parse_undirected_gr(gr_file);
+        const int nb_nodes = graph.nb_vertices();
+
+        // the vertex of maximal degree lies in the giant component
+        const auto s = std::ranges::max(graph.vertices(), {}, [&](auto u) {
+            return std::ranges::distance(graph.out_arcs(u));
+        });
+        const unit_length_map lengths;
+        graph_diameter<static_digraph, unit_length_map, length_class::uniform>
+            diameter(graph, lengths);
+
+        // the diameter column of double_sweep holds a lower bound
+        auto print_row = [&](const char * algorithm, const int d,
+                             const std::optional<int> r, const double time_ms) {
+            std::cout << gr_file.stem() << ',' << nb_nodes << ','
+                      << graph.nb_arcs() << ',' << diameter.component_size()
+                      << ',' << algorithm << ',' << d << ',';
+            if(r.has_value()) std::cout << r.value();
+            std::cout << ',' << diameter.nb_searches() << ',' << time_ms
+                      << std::endl;
+        };
+
+        {
+            Chrono chrono;
+            const int lower_bound = diameter.double_sweep(s);
+            print_row("double_sweep", lower_bound, std::nullopt,
+                      chrono.timeUs() / 1000.0);
+        }
+        {
+            Chrono chrono;
+            const int d = diameter.ifub(s);
+            print_row("ifub", d, std::nullopt, chrono.timeUs() / 1000.0);
+        }
+        {
+            Chrono chrono;
+            const auto [d, r] = diameter.bounding_diameters(s);
+            print_row("bounding_diameters", d, r, chrono.timeUs() / 1000.0);
+        }
+    }
+    return 0;
+}
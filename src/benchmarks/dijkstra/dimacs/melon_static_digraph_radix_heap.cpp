@@ -0,0 +1,93 @@
+#include <filesystem>
+#include <iostream>
+#include <type_traits>
+
+#include "melon/algorithm/dijkstra.hpp"
+#include "melon/container/static_digraph.hpp"
+
+#include "chrono.hpp"
+#include "counting_heap.hpp"
+#include "melon_parsers.hpp"
+#include "radix_heap.hpp"
+#include "warm_up.hpp"
+
+using namespace fhamonic::melon;
+
+struct dijkstra_traits {
+    using semiring = shortest_path_semiring<unsigned int>;
+    using heap = radix_heap<vertex_t<static_digraph>, unsigned int,
+                            vertex_map_t<static_digraph, std::size_t>>;
+
+    static constexpr bool store_paths = false;
+    static constexpr bool store_distances = false;
+};
+
+struct counting_dijkstra_traits : dijkstra_traits {
+    using heap = counting_heap<dijkstra_traits::heap>;
+};
+
+int main() {
+    std::vector<std::filesystem::path> gr_files(
+        {"data/9th_DIMACS_USA_roads/distance/USA-road-d.NY.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NY.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.BAY.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.BAY.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.COL.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.COL.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.FLA.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.FLA.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.NW.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NW.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.NE.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NE.gr"});
+
+    std::cout << "instance,nb_nodes,nb_arcs,time_ms,avg_push,avg_promote,"
+                 "avg_pop\n";
+
+    (void)warm_up();
+
+    for(const auto & gr_file : gr_files) {
+        auto [graph, length_map] =
+            parse_melon_weighted_digraph<static_digraph, unsigned int>(
+                gr_file);
+
+        Chrono gr_chrono;
+        double avg_time = 0;
+        int iterations = 0;
+        const int nb_nodes = graph.nb_vertices();
+        const int nb_iterations = 30000.0 * 1000.0 / nb_nodes;
+        for(auto && s : graph.vertices()) {
+            Chrono chrono;
+
+            double sum = 0;
+            for(auto && [u, dist] :
+                dijkstra(dijkstra_traits{}, graph, length_map, s)) {
+                sum += dist;
+            }
+
+            double time_ms = (chrono.timeUs() / 1000.0);
+            avg_time += time_ms;
+            ++iterations;
+            if(iterations >= nb_iterations) break;
+        }
+        avg_time /= iterations;
+
+        // operations are counted in a separate pass to keep timings clean
+        auto & counts = counting_dijkstra_traits::heap::counts;
+        counts.reset();
+        iterations = 0;
+        for(auto && s : graph.vertices()) {
+            dijkstra algo(counting_dijkstra_traits{}, graph, length_map, s);
+            algo.run();
+            ++iterations;
+            if(iterations >= nb_iterations) break;
+        }
+
+        std::cout << gr_file.stem() << ',' << nb_nodes << ',' << graph.nb_arcs()
+                  << ',' << avg_time << ','
+                  << double(counts.nb_push) / iterations << ','
+                  << double(counts.nb_promote) / iterations << ','
+                  << double(counts.nb_pop) / iterations << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "chrono.hpp"
+
+#include "melon/algorithm/dijkstra.hpp"
+#include "melon/container/static_digraph.hpp"
+#include "melon/utility/static_digraph_builder.hpp"
+
+#include "dispatching_sssp.hpp"
+#include "warm_up.hpp"
+
+using namespace fhamonic::melon;
+
+auto parse_gr(const std::filesystem::path & file_name) {
+    std::ifstream gr_file(file_name);
+    std::size_t nb_nodes, nb_arcs;
+    gr_file >> nb_nodes >> nb_arcs;
+
+    static_digraph_builder<static_digraph, int> builder(nb_nodes);
+
+    vertex_t<static_digraph> from, to;
+    while(gr_file >> from >> to) builder.add_arc(from, to, 1);
+
+    return builder.build();
+}
+
+const char * algorithm_name(const length_class c) {
+    switch(c) {
+        case length_class::uniform:
+            return "bfs";
+        case length_class::zero_or_unit:
+            return "zero_one_bfs";
+        case length_class::small_integer:
+            return "dial";
+        default:
+            return "dijkstra";
+    }
+}
+
+int main() {
+    std::vector<std::filesystem::path> gr_files(
+        {"data/web-Stanford.txt", "data/Amazon0505.txt", "data/WikiTalk.txt"});
+    // the unit lengths of the SNAP graphs, then random 0/1 and 1..16 lengths
+    const std::vector<std::string> length_models = {"unit", "zero_one",
+                                                    "small_integer"};
+
+    std::cout << "instance,nb_nodes,nb_arcs,lengths,time_ms,"
+                 "specialized_algorithm,specialized_time_ms,speedup,"
+                 "identical_distances\n";
+
+    (void)warm_up();
+
+    for(const auto & gr_file : gr_files) {
+        auto [graph, unit_length_map] = parse_gr(gr_file);
+
+        for(const std::string & length_model : length_models) {
+            auto length_map = unit_length_map;
+            if(length_model != "unit") {
+                std::mt19937 rng(1234);
+                std::uniform_int_distribution<int> length_dist(
+                    length_model == "zero_one" ? 0 : 1,
+                    length_model == "zero_one" ? 1 : 16);
+                for(auto && a : graph.arcs()) length_map[a] = length_dist(rng);
+            }
+
+            dispatching_sssp specialized(graph, length_map);
+            std::vector<int> dist_map(graph.nb_vertices(), -1);
+            double avg_time = 0;
+            double avg_specialized_time = 0;
+            bool identical = true;
+            int iterations = 0;
+            const int nb_nodes = graph.nb_vertices();
+            const int nb_iterations = 30000.0 * 1000.0 / nb_nodes;
+            for(auto && s : graph.vertices()) {
+                Chrono chrono;
+
+                int sum = 0;
+                dijkstra algo(graph, length_map);
+                algo.add_source(s);
+                while(!algo.finished()) {
+                    auto [u, dist] = algo.current();
+                    algo.advance();
+                    sum += dist;
+                }
+
+                for(auto && [u, dist] : algo) {
+                    sum += dist;
+                }
+
+                double time_ms = (chrono.timeUs() / 1000.0);
+                avg_time += time_ms;
+
+                // untimed reference distances
+                dijkstra reference(graph, length_map);
+                reference.add_source(s);
+                for(auto && [u, dist] : reference) dist_map[u] = dist;
+
+                Chrono specialized_chrono;
+                specialized.run(s);
+                avg_specialized_time += specialized_chrono.timeUs() / 1000.0;
+
+                for(auto && u : graph.vertices()) {
+                    identical &= (specialized.reached(u)
+                                      ? specialized.dist(u)
+                                      : -1) == dist_map[u];
+                    dist_map[u] = -1;
+                }
+                ++iterations;
+                if(iterations >= nb_iterations) break;
+            }
+            avg_time /= iterations;
+            avg_specialized_time /= iterations;
+
+            std::cout << gr_file.stem() << ',' << nb_nodes << ','
+                      << graph.nb_arcs() << ',' << length_model << ','
+                      << avg_time << ','
+                      << algorithm_name(specialized.algorithm()) << ','
+                      << avg_specialized_time << ','
+                      << avg_time / avg_specialized_time << ',' << identical
+                      << std::endl;
+        }
+    }
+    return 0;
+}
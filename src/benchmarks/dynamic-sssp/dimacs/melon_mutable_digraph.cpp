@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "melon/algorithm/dijkstra.hpp"
+#include "melon/container/mutable_digraph.hpp"
+#include "melon/container/static_digraph.hpp"
+
+#include "chrono.hpp"
+#include "dynamic_shortest_paths.hpp"
+#include "melon_parsers.hpp"
+#include "warm_up.hpp"
+
+using namespace fhamonic::melon;
+
+int main() {
+    std::vector<std::filesystem::path> gr_files(
+        {"data/9th_DIMACS_USA_roads/time/USA-road-t.NY.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.BAY.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.COL.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.FLA.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NW.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NE.gr"});
+    const std::vector<std::size_t> batch_sizes = {1, 10, 100, 1000};
+    const std::size_t nb_batches = 100;
+
+    std::cout << "instance,nb_nodes,nb_arcs,batch_size,update_time_ms,"
+                 "recompute_time_ms,speedup,scanned_per_update,"
+                 "identical_distances\n";
+
+    (void)warm_up();
+
+    for(const auto & gr_file : gr_files) {
+        auto [sgraph, slength_map] =
+            parse_melon_weighted_digraph<static_digraph, double>(gr_file);
+
+        mutable_digraph graph;
+        for(std::size_t i = 0; i < sgraph.nb_vertices(); ++i) {
+            (void)graph.create_vertex();
+        }
+        for(auto && [a, arc_pair] : arcs_entries(sgraph)) {
+            (void)graph.create_arc(arc_pair.first, arc_pair.second);
+        }
+        auto length_map = create_arc_map<double>(graph);
+        std::vector<arc_t<mutable_digraph>> arcs_list;
+        std::size_t cpt = 0;
+        for(auto && [a, arc_pair] : arcs_entries(sgraph)) {
+            length_map[cpt] = slength_map[a];
+            arcs_list.push_back(cpt);
+            ++cpt;
+        }
+        const auto initial_length_map = length_map;
+
+        const int nb_nodes = graph.nb_vertices();
+        const vertex_t<mutable_digraph> s = 0;
+        std::mt19937 rng(1234);
+        std::uniform_int_distribution<std::size_t> arc_dist(
+            0, arcs_list.size() - 1);
+        // travel times are scaled by a traffic factor and kept integral so
+        // that both computations sum exactly the same values
+        std::uniform_real_distribution<double> factor_dist(0.5, 2.0);
+        std::vector<double> recomputed_dist_map(nb_nodes);
+
+        for(const std::size_t batch_size : batch_sizes) {
+            length_map = initial_length_map;
+            dynamic_shortest_paths dsp(graph, length_map, s);
+
+            double update_time = 0;
+            double recompute_time = 0;
+            std::size_t nb_scanned = 0;
+            bool identical = true;
+            std::vector<std::pair<arc_t<mutable_digraph>, double>> changes;
+            for(std::size_t i = 0; i < nb_batches; ++i) {
+                changes.clear();
+                for(std::size_t j = 0; j < batch_size; ++j) {
+                    const auto a = arcs_list[arc_dist(rng)];
+                    changes.emplace_back(
+                        a, std::max(1.0, std::round(initial_length_map[a] *
+                                                    factor_dist(rng))));
+                }
+
+                Chrono update_chrono;
+                dsp.update(changes);
+                update_time += update_chrono.timeUs() / 1000.0;
+                nb_scanned += dsp.nb_scanned();
+
+                std::fill(recomputed_dist_map.begin(),
+                          recomputed_dist_map.end(), -1.0);
+                Chrono recompute_chrono;
+                for(auto && [u, dist] :
+                    dijkstra(graph, mapping_ref_view(length_map), s)) {
+                    recomputed_dist_map[u] = dist;
+                }
+                recompute_time += recompute_chrono.timeUs() / 1000.0;
+
+                for(auto && u : graph.vertices())
+                    identical &= (dsp.reached(u) ? dsp.dist(u) : -1.0) ==
+                                 recomputed_dist_map[u];
+            }
+
+            std::cout << gr_file.stem() << ',' << nb_nodes << ','
+                      << graph.nb_arcs() << ',' << batch_size << ','
+                      << update_time / nb_batches << ','
+                      << recompute_time / nb_batches << ','
+                      << recompute_time / update_time << ','
+                      << double(nb_scanned) / nb_batches << ',' << identical
+                      << std::endl;
+        }
+    }
+    return 0;
+}
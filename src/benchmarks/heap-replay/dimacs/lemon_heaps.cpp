@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <lemon/bin_heap.h>
+#include <lemon/dheap.h>
+#include <lemon/quad_heap.h>
+
+#include "chrono.hpp"
+#include "heap_trace.hpp"
+#include "warm_up.hpp"
+
+using namespace lemon;
+
+// Cross reference map of the lemon heaps, indexed by the ids of the trace
+struct id_int_map {
+    typedef std::uint32_t Key;
+    typedef int Value;
+
+    std::vector<int> indices;
+
+    explicit id_int_map(std::size_t nb_ids) : indices(nb_ids, -1) {}
+    int operator[](const Key & id) const { return indices[id]; }
+    void set(const Key & id, const int index) { indices[id] = index; }
+};
+
+// Replays the trace on a new heap and returns the time in ms, pops whose
+// priority differs from the recorded one are counted in nb_mismatches
+template <typename Heap>
+double replay(const heap_trace & trace, std::size_t & nb_mismatches) {
+    id_int_map indices(trace.nb_ids);
+    Heap heap(indices);
+    Chrono chrono;
+    for(const heap_operation & op : trace.operations) {
+        switch(op.type) {
+            case heap_operation_type::push:
+                heap.push(op.id, op.priority);
+                break;
+            case heap_operation_type::promote:
+                heap.decrease(op.id, op.priority);
+                break;
+            case heap_operation_type::pop:
+                nb_mismatches += (heap.prio() != op.priority);
+                heap.pop();
+                break;
+            case heap_operation_type::clear:
+                heap.clear();
+                break;
+        }
+    }
+    return chrono.timeUs() / 1000.0;
+}
+
+template <typename Heap>
+void benchmark(const std::filesystem::path & trace_file,
+               const heap_trace & trace, const std::string & heap_name) {
+    const int nb_iterations = std::max(
+        1.0, 30000.0 * 1000.0 / static_cast<double>(trace.operations.size()));
+    double avg_time = 0;
+    std::size_t nb_mismatches = 0;
+    for(int i = 0; i < nb_iterations; ++i)
+        avg_time += replay<Heap>(trace, nb_mismatches);
+    avg_time /= nb_iterations;
+
+    std::cout << trace_file.stem() << ',' << trace.nb_ids << ','
+              << trace.operations.size() << ',' << heap_name << ','
+              << avg_time << ','
+              << avg_time * 1e6 / static_cast<double>(trace.operations.size())
+              << ',' << (nb_mismatches == 0) << std::endl;
+}
+
+int main() {
+    std::vector<std::filesystem::path> trace_files(
+        {"traces/dijkstra/USA-road-d.NY.trace",
+         "traces/dijkstra/USA-road-t.NY.trace",
+         "traces/dijkstra/USA-road-d.BAY.trace",
+         "traces/dijkstra/USA-road-t.BAY.trace",
+         "traces/dijkstra/USA-road-d.COL.trace",
+         "traces/dijkstra/USA-road-t.COL.trace",
+         "traces/dijkstra/USA-road-d.FLA.trace",
+         "traces/dijkstra/USA-road-t.FLA.trace",
+         "traces/dijkstra/USA-road-d.NW.trace",
+         "traces/dijkstra/USA-road-t.NW.trace",
+         "traces/dijkstra/USA-road-d.NE.trace",
+         "traces/dijkstra/USA-road-t.NE.trace"});
+
+    std::cout << "instance,nb_ids,nb_operations,heap,time_ms,ns_per_operation,"
+                 "consistent\n";
+
+    (void)warm_up();
+
+    for(const auto & trace_file : trace_files) {
+        const heap_trace trace = read_heap_trace(trace_file);
+        benchmark<BinHeap<std::uint32_t, id_int_map>>(trace_file, trace,
+                                                      "lemon_BinHeap");
+        benchmark<QuadHeap<std::uint32_t, id_int_map>>(trace_file, trace,
+                                                       "lemon_QuadHeap");
+        benchmark<DHeap<std::uint32_t, id_int_map, 8>>(trace_file, trace,
+                                                       "lemon_DHeap_8");
+        benchmark<DHeap<std::uint32_t, id_int_map, 16>>(trace_file, trace,
+                                                        "lemon_DHeap_16");
+    }
+    return 0;
+}
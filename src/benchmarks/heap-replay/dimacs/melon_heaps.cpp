@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "melon/algorithm/dijkstra.hpp"
+
+#include "chrono.hpp"
+#include "heap_trace.hpp"
+#include "pairing_heap.hpp"
+#include "radix_heap.hpp"
+#include "sequence_heap.hpp"
+#include "warm_up.hpp"
+
+using namespace fhamonic::melon;
+
+using entry_less = decltype([](const auto & e1, const auto & e2) {
+    return e1.second < e2.second;
+});
+template <std::size_t D>
+using melon_d_ary_heap = d_ary_heap<D, std::uint32_t, std::uint32_t, entry_less,
+                                    std::vector<std::size_t>>;
+
+// Replays the trace on a new heap and returns the time in ms, pops whose
+// priority differs from the recorded one are counted in nb_mismatches
+template <typename Heap>
+double replay(const heap_trace & trace, std::size_t & nb_mismatches) {
+    Heap heap(std::vector<std::size_t>(trace.nb_ids));
+    Chrono chrono;
+    for(const heap_operation & op : trace.operations) {
+        switch(op.type) {
+            case heap_operation_type::push:
+                heap.push(op.id, op.priority);
+                break;
+            case heap_operation_type::promote:
+                heap.promote(op.id, op.priority);
+                break;
+            case heap_operation_type::pop:
+                nb_mismatches += (heap.top().second != op.priority);
+                heap.pop();
+                break;
+            case heap_operation_type::clear:
+                heap.clear();
+                break;
+        }
+    }
+    return chrono.timeUs() / 1000.0;
+}
+
+template <typename Heap>
+void benchmark(const std::filesystem::path & trace_file,
+               const heap_trace & trace, const std::string & heap_name) {
+    const int nb_iterations = std::max(
+        1.0, 30000.0 * 1000.0 / static_cast<double>(trace.operations.size()));
+    double avg_time = 0;
+    std::size_t nb_mismatches = 0;
+    for(int i = 0; i < nb_iterations; ++i)
+        avg_time += replay<Heap>(trace, nb_mismatches);
+    avg_time /= nb_iterations;
+
+    std::cout << trace_file.stem() << ',' << trace.nb_ids << ','
+              << trace.operations.size() << ',' << heap_name << ','
+              << avg_time << ','
+              << avg_time * 1e6 / static_cast<double>(trace.operations.size())
+              << ',' << (nb_mismatches == 0) << std::endl;
+}
+
+int main() {
+    std::vector<std::filesystem::path> trace_files(
+        {"traces/dijkstra/USA-road-d.NY.trace",
+         "traces/dijkstra/USA-road-t.NY.trace",
+         "traces/dijkstra/USA-road-d.BAY.trace",
+         "traces/dijkstra/USA-road-t.BAY.trace",
+         "traces/dijkstra/USA-road-d.COL.trace",
+         "traces/dijkstra/USA-road-t.COL.trace",
+         "traces/dijkstra/USA-road-d.FLA.trace",
+         "traces/dijkstra/USA-road-t.FLA.trace",
+         "traces/dijkstra/USA-road-d.NW.trace",
+         "traces/dijkstra/USA-road-t.NW.trace",
+         "traces/dijkstra/USA-road-d.NE.trace",
+         "traces/dijkstra/USA-road-t.NE.trace"});
+
+    std::cout << "instance,nb_ids,nb_operations,heap,time_ms,ns_per_operation,"
+                 "consistent\n";
+
+    (void)warm_up();
+
+    for(const auto & trace_file : trace_files) {
+        const heap_trace trace = read_heap_trace(trace_file);
+        benchmark<melon_d_ary_heap<2>>(trace_file, trace, "melon_2_heap");
+        benchmark<melon_d_ary_heap<4>>(trace_file, trace, "melon_4_heap");
+        benchmark<melon_d_ary_heap<8>>(trace_file, trace, "melon_8_heap");
+        benchmark<melon_d_ary_heap<16>>(trace_file, trace, "melon_16_heap");
+        benchmark<pairing_heap<std::uint32_t, std::uint32_t>>(
+            trace_file, trace, "pairing_heap");
+        benchmark<sequence_heap<std::uint32_t, std::uint32_t>>(
+            trace_file, trace, "sequence_heap");
+        benchmark<radix_heap<std::uint32_t, std::uint32_t>>(
+            trace_file, trace, "radix_heap");
+    }
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "melon/algorithm/dijkstra.hpp"
+#include "melon/container/static_digraph.hpp"
+
+#include "chrono.hpp"
+#include "dijkstra_workspace.hpp"
+#include "isochrone.hpp"
+#include "melon_parsers.hpp"
+#include "warm_up.hpp"
+
+using namespace fhamonic::melon;
+
+struct dijkstra_traits {
+    using semiring = shortest_path_semiring<double>;
+    using heap = d_ary_heap<2, vertex_t<static_digraph>, double,
+                            decltype([](const auto & e1, const auto & e2) {
+                                return semiring::less(e1.second, e2.second);
+                            }),
+                            vertex_map_t<static_digraph, std::size_t>>;
+
+    static constexpr bool store_paths = false;
+    static constexpr bool store_distances = false;
+};
+
+int main() {
+    std::vector<std::filesystem::path> gr_files(
+        {"data/9th_DIMACS_USA_roads/distance/USA-road-d.NY.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NY.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.BAY.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.BAY.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.COL.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.COL.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.FLA.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.FLA.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.NW.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NW.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.NE.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NE.gr"});
+    // radii in multiples of the average arc length of the instance
+    const std::vector<double> radius_factors = {16.0, 64.0, 256.0, 1024.0};
+    const std::size_t nb_queries = 1000;
+
+    std::cout << "instance,nb_nodes,nb_arcs,radius,time_ms,avg_reached,"
+                 "avg_frontier_arcs\n";
+
+    (void)warm_up();
+
+    for(const auto & gr_file : gr_files) {
+        auto [graph, length_map] =
+            parse_melon_weighted_digraph<static_digraph, double>(gr_file);
+
+        const int nb_nodes = graph.nb_vertices();
+        double total_length = 0;
+        for(auto && a : graph.arcs()) total_length += length_map[a];
+        const double avg_length = total_length / graph.nb_arcs();
+
+        std::vector<std::pair<vertex_t<static_digraph>, double>>
+            reached_entries;
+        std::vector<arc_t<static_digraph>> frontier_arcs;
+        dijkstra_workspace workspace(dijkstra_traits{}, graph, length_map);
+
+        for(const double radius_factor : radius_factors) {
+            const double radius = radius_factor * avg_length;
+            std::mt19937 rng(1234);
+            std::uniform_int_distribution<vertex_t<static_digraph>>
+                vertex_dist(0, static_cast<vertex_t<static_digraph>>(
+                                   nb_nodes - 1));
+            std::size_t nb_reached = 0;
+            std::size_t nb_frontier_arcs = 0;
+            Chrono chrono;
+            for(std::size_t i = 0; i < nb_queries; ++i) {
+                workspace.reset();
+                workspace.add_source(vertex_dist(rng));
+                isochrone_search(workspace, graph, length_map, radius,
+                                 reached_entries, frontier_arcs);
+                nb_reached += reached_entries.size();
+                nb_frontier_arcs += frontier_arcs.size();
+            }
+            double avg_time = (chrono.timeUs() / 1000.0) / nb_queries;
+
+            std::cout << gr_file.stem() << ',' << nb_nodes << ','
+                      << graph.nb_arcs() << ',' << radius << ',' << avg_time
+                      << ',' << double(nb_reached) / nb_queries << ','
+                      << double(nb_frontier_arcs) / nb_queries << std::endl;
+        }
+    }
+    return 0;
+}
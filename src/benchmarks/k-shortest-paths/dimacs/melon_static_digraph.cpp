@@ -0,0 +1,94 @@
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <type_traits>
+
+#include "melon/algorithm/dijkstra.hpp"
+#include "melon/container/static_digraph.hpp"
+
+#include "chrono.hpp"
+#include "k_shortest_paths.hpp"
+#include "melon_parsers.hpp"
+#include "warm_up.hpp"
+
+using namespace fhamonic::melon;
+
+// Targets are taken at a fixed Dijkstra rank from random sources, so that
+// the queries stay comparable whatever the graph size
+auto generate_queries(const static_digraph & graph,
+                      const std::vector<double> & length_map,
+                      const std::size_t nb_queries,
+                      const std::size_t dijkstra_rank) {
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<vertex_t<static_digraph>> vertex_dist(
+        0, static_cast<vertex_t<static_digraph>>(graph.nb_vertices() - 1));
+    std::vector<std::pair<vertex_t<static_digraph>, vertex_t<static_digraph>>>
+        queries;
+    for(std::size_t i = 0; i < nb_queries; ++i) {
+        const auto s = vertex_dist(rng);
+        auto t = s;
+        std::size_t rank = 0;
+        for(auto && [u, dist] : dijkstra(graph, length_map, s)) {
+            t = u;
+            if(++rank >= dijkstra_rank) break;
+        }
+        queries.emplace_back(s, t);
+    }
+    return queries;
+}
+
+int main() {
+    std::vector<std::filesystem::path> gr_files(
+        {"data/9th_DIMACS_USA_roads/distance/USA-road-d.NY.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NY.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.BAY.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.BAY.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.COL.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.COL.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.FLA.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.FLA.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.NW.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NW.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.NE.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NE.gr"});
+    std::vector<std::size_t> ks({2, 4, 8, 16});
+    const std::size_t nb_queries = 100;
+    const std::size_t dijkstra_rank = 1 << 12;
+
+    std::cout << "instance,nb_nodes,nb_arcs,k,time_ms,dijkstra_runs,"
+                 "tree_spurs,nb_paths\n";
+
+    (void)warm_up();
+
+    for(const auto & gr_file : gr_files) {
+        auto [graph, length_map] =
+            parse_melon_weighted_digraph<static_digraph, double>(gr_file);
+        const auto queries =
+            generate_queries(graph, length_map, nb_queries, dijkstra_rank);
+        const int nb_nodes = graph.nb_vertices();
+
+        k_shortest_paths<static_digraph, std::vector<double>> algo(
+            graph, length_map);
+        for(const std::size_t k : ks) {
+            double nb_dijkstra_runs = 0;
+            double nb_tree_spurs = 0;
+            double nb_paths = 0;
+            Chrono chrono;
+            for(auto && [s, t] : queries) {
+                algo.run(s, t, k);
+                nb_dijkstra_runs +=
+                    static_cast<double>(algo.nb_dijkstra_runs());
+                nb_tree_spurs += static_cast<double>(algo.nb_tree_spurs());
+                nb_paths += static_cast<double>(algo.paths().size());
+            }
+            double avg_time = (chrono.timeUs() / 1000.0) / nb_queries;
+
+            std::cout << gr_file.stem() << ',' << nb_nodes << ','
+                      << graph.nb_arcs() << ',' << k << ',' << avg_time
+                      << ',' << nb_dijkstra_runs / nb_queries << ','
+                      << nb_tree_spurs / nb_queries << ','
+                      << nb_paths / nb_queries << std::endl;
+        }
+    }
+    return 0;
+}
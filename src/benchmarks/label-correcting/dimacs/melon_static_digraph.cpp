@@ -0,0 +1,158 @@
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "melon/algorithm/dijkstra.hpp"
+#include "melon/container/static_digraph.hpp"
+
+#include "chrono.hpp"
+#include "label_correcting.hpp"
+#include "melon_parsers.hpp"
+#include "negative_arc_lengths.hpp"
+#include "warm_up.hpp"
+
+using namespace fhamonic::melon;
+
+// shifted distances can be negative, so no negative value can mark the
+// unreached vertices
+constexpr double unreached = std::numeric_limits<double>::max();
+
+struct benchmark_result {
+    double time_ms = 0;
+    double scans_per_vertex = 0;
+    bool identical = true;
+    double cycle_detection_time_ms = 0;
+    bool cycle_detected = true;
+};
+
+// Runs the label correcting algorithm Algo from each source, compares the
+// distances with the shifted Dijkstra distances of the original lengths,
+// then measures the detection of a negative cycle in cyclic_lengths
+template <template <typename, typename> typename Algo>
+benchmark_result run_algorithm(
+    const static_digraph & graph,
+    const potential_shifted_lengths<double> & shifted,
+    const std::vector<double> & cyclic_lengths,
+    const std::vector<vertex_t<static_digraph>> & sources,
+    const std::vector<std::vector<double>> & dijkstra_dist_maps) {
+    benchmark_result result;
+    Algo<static_digraph, std::vector<double>> algo(graph, shifted.lengths);
+    std::size_t nb_scans = 0;
+    for(std::size_t i = 0; i < sources.size(); ++i) {
+        const auto s = sources[i];
+        Chrono chrono;
+        result.identical &= algo.run(s);
+        result.time_ms += chrono.timeUs() / 1000.0;
+        nb_scans += algo.nb_scans();
+        for(auto && u : graph.vertices()) {
+            const double expected =
+                dijkstra_dist_maps[i][u] == unreached
+                    ? unreached
+                    : dijkstra_dist_maps[i][u] + shifted.potentials[s] -
+                          shifted.potentials[u];
+            result.identical &= (algo.reached(u) ? algo.dist(u) : unreached) ==
+                                expected;
+        }
+    }
+    result.time_ms /= sources.size();
+    result.scans_per_vertex =
+        double(nb_scans) / sources.size() / graph.nb_vertices();
+
+    Algo<static_digraph, std::vector<double>> cyclic_algo(graph,
+                                                          cyclic_lengths);
+    for(const auto s : sources) {
+        Chrono chrono;
+        result.cycle_detected &= !cyclic_algo.run(s);
+        result.cycle_detection_time_ms += chrono.timeUs() / 1000.0;
+        double cycle_length = 0;
+        for(auto && a : cyclic_algo.negative_cycle())
+            cycle_length += cyclic_lengths[a];
+        result.cycle_detected &= cycle_length < 0;
+    }
+    result.cycle_detection_time_ms /= sources.size();
+    return result;
+}
+
+int main() {
+    std::vector<std::filesystem::path> gr_files(
+        {"data/9th_DIMACS_USA_roads/distance/USA-road-d.NY.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NY.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.BAY.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.BAY.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.COL.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.COL.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.FLA.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.FLA.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.NW.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NW.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.NE.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NE.gr"});
+    // maximal potential in multiples of the average arc length, the label
+    // correcting algorithms compare the same sums whatever the potential so
+    // that it only sets the ratio of negative arcs
+    const double potential_factor = 4.0;
+    const std::size_t nb_sources = 5;
+
+    std::cout << "instance,nb_nodes,nb_arcs,negative_arcs_ratio,algorithm,"
+                 "time_ms,scans_per_vertex,dijkstra_time_ms,"
+                 "identical_distances,cycle_detection_time_ms,"
+                 "cycle_detected\n";
+
+    (void)warm_up();
+
+    for(const auto & gr_file : gr_files) {
+        auto [graph, length_map] =
+            parse_melon_weighted_digraph<static_digraph, double>(gr_file);
+
+        const int nb_nodes = graph.nb_vertices();
+        double total_length = 0;
+        for(auto && a : graph.arcs()) total_length += length_map[a];
+        const double avg_length = total_length / graph.nb_arcs();
+
+        std::mt19937 rng(1234);
+        std::uniform_int_distribution<vertex_t<static_digraph>> vertex_dist(
+            0, static_cast<vertex_t<static_digraph>>(nb_nodes - 1));
+        std::vector<vertex_t<static_digraph>> sources;
+        for(std::size_t i = 0; i < nb_sources; ++i)
+            sources.push_back(vertex_dist(rng));
+
+        // shortest paths of the nonnegative lengths as reference
+        std::vector<std::vector<double>> dijkstra_dist_maps(
+            nb_sources, std::vector<double>(nb_nodes, unreached));
+        Chrono dijkstra_chrono;
+        for(std::size_t i = 0; i < nb_sources; ++i)
+            for(auto && [u, dist] : dijkstra(graph, length_map, sources[i]))
+                dijkstra_dist_maps[i][u] = dist;
+        const double dijkstra_time =
+            (dijkstra_chrono.timeUs() / 1000.0) / nb_sources;
+
+        const auto shifted = generate_negative_arc_lengths(
+            graph, length_map, potential_factor * avg_length);
+        std::size_t nb_negative_arcs = 0;
+        for(auto && a : graph.arcs())
+            nb_negative_arcs += shifted.lengths[a] < 0;
+        std::vector<double> cyclic_lengths = shifted.lengths;
+        (void)insert_negative_cycle(graph, cyclic_lengths);
+
+        auto print = [&](const std::string & algorithm,
+                         const benchmark_result & r) {
+            std::cout << gr_file.stem() << ',' << nb_nodes << ','
+                      << graph.nb_arcs() << ','
+                      << double(nb_negative_arcs) / graph.nb_arcs() << ','
+                      << algorithm << ',' << r.time_ms << ','
+                      << r.scans_per_vertex << ',' << dijkstra_time << ','
+                      << r.identical << ',' << r.cycle_detection_time_ms
+                      << ',' << r.cycle_detected << std::endl;
+        };
+        print("spfa", run_algorithm<spfa>(graph, shifted, cyclic_lengths,
+                                          sources, dijkstra_dist_maps));
+        print("goldberg_radzik",
+              run_algorithm<goldberg_radzik>(graph, shifted, cyclic_lengths,
+                                             sources, dijkstra_dist_maps));
+    }
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <span>
+#include <sstream>
+#include <vector>
+
+#include "chrono.hpp"
+
+#include "melon/algorithm/breadth_first_search.hpp"
+#include "melon/container/static_digraph.hpp"
+#include "melon/utility/static_digraph_builder.hpp"
+
+#include "multi_source_bfs.hpp"
+#include "warm_up.hpp"
+
+using namespace fhamonic::melon;
+
+auto parse_gr(const std::filesystem::path & file_name) {
+    std::ifstream gr_file(file_name);
+    std::size_t nb_nodes, nb_arcs;
+    gr_file >> nb_nodes >> nb_arcs;
+
+    static_digraph_builder<static_digraph> builder(nb_nodes);
+
+    vertex_t<static_digraph> from, to;
+    while(gr_file >> from >> to) builder.add_arc(from, to);
+
+    return builder.build();
+}
+
+// Runs the sources by batches of 64 * Words and prints the amortized time
+// per source against the repeated BFS
+template <std::size_t Words>
+void benchmark_batches(
+    const std::filesystem::path & gr_file, const static_digraph & graph,
+    const std::vector<vertex_t<static_digraph>> & sources,
+    const std::vector<std::uint64_t> & nb_reached,
+    const std::vector<std::uint64_t> & distance_sums,
+    const double bfs_time_per_source) {
+    multi_source_bfs<static_digraph, Words> ms_bfs(graph);
+    constexpr std::size_t batch_size = decltype(ms_bfs)::max_nb_sources;
+    double time = 0;
+    bool identical = true;
+    for(std::size_t first = 0; first < sources.size(); first += batch_size) {
+        const std::span<const vertex_t<static_digraph>> batch(
+            sources.data() + first,
+            std::min(batch_size, sources.size() - first));
+        Chrono chrono;
+        ms_bfs.run(batch);
+        time += chrono.timeUs() / 1000.0;
+        for(std::size_t i = 0; i < batch.size(); ++i)
+            identical &= ms_bfs.nb_reached(i) == nb_reached[first + i] &&
+                         ms_bfs.distance_sum(i) == distance_sums[first + i];
+    }
+    const double time_per_source = time / sources.size();
+
+    std::cout << gr_file.stem() << ',' << graph.nb_vertices() << ','
+              << graph.nb_arcs() << ',' << batch_size << ','
+              << time_per_source << ',' << bfs_time_per_source << ','
+              << bfs_time_per_source / time_per_source << ',' << identical
+              << std::endl;
+}
+
+int main() {
+    std::vector<std::filesystem::path> gr_files(
+        {"data/web-Stanford.txt", "data/Amazon0505.txt", "data/WikiTalk.txt"});
+    const std::size_t nb_sources = 512;
+
+    std::cout << "instance,nb_nodes,nb_arcs,batch_size,time_per_source_ms,"
+                 "bfs_time_per_source_ms,speedup,identical_results\n";
+
+    (void)warm_up();
+
+    for(const auto & gr_file : gr_files) {
+        auto [graph] = parse_gr(gr_file);
+        const std::size_t nb_nodes = graph.nb_vertices();
+
+        std::vector<vertex_t<static_digraph>> sources;
+        for(std::size_t i = 0; i < nb_sources; ++i)
+            sources.push_back(static_cast<vertex_t<static_digraph>>(
+                i * (nb_nodes / nb_sources)));
+
+        std::vector<std::uint64_t> nb_reached;
+        std::vector<std::uint64_t> distance_sums;
+        std::vector<std::uint32_t> level_map(nb_nodes);
+        std::vector<vertex_t<static_digraph>> order;
+        double bfs_time = 0;
+        for(const auto s : sources) {
+            Chrono chrono;
+            int sum = 0;
+            breadth_first_search bfs(graph);
+            bfs.add_source(s);
+            for(const auto & u : bfs) sum += u;
+            bfs_time += chrono.timeUs() / 1000.0;
+
+            // melon's BFS visits the vertices by nondecreasing levels, from
+            // which the reference distance sums are recovered in an untimed
+            // search
+            order.clear();
+            breadth_first_search reference(graph);
+            reference.add_source(s);
+            for(const auto & u : reference) order.push_back(u);
+            constexpr std::uint32_t unreached = ~std::uint32_t{0};
+            std::fill(level_map.begin(), level_map.end(), unreached);
+            level_map[s] = 0;
+            std::uint64_t distance_sum = 0;
+            for(const auto u : order) {
+                distance_sum += level_map[u];
+                for(auto && a : graph.out_arcs(u))
+                    if(level_map[graph.arc_target(a)] == unreached)
+                        level_map[graph.arc_target(a)] = level_map[u] + 1;
+            }
+            nb_reached.push_back(order.size());
+            distance_sums.push_back(distance_sum);
+        }
+        const double bfs_time_per_source = bfs_time / nb_sources;
+
+        benchmark_batches<1>(gr_file, graph, sources, nb_reached,
+                             distance_sums, bfs_time_per_source);
+        benchmark_batches<2>(gr_file, graph, sources, nb_reached,
+                             distance_sums, bfs_time_per_source);
+        benchmark_batches<4>(gr_file, graph, sources, nb_reached,
+                             distance_sums, bfs_time_per_source);
+        benchmark_batches<8>(gr_file, graph, sources, nb_reached,
+                             distance_sums, bfs_time_per_source);
+    }
+    return 0;
+}
@@ -0,0 +1,119 @@
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <type_traits>
+
+#include "melon/algorithm/dijkstra.hpp"
+#include "melon/container/static_digraph.hpp"
+
+#include "chrono.hpp"
+#include "melon_parsers.hpp"
+#include "multilevel_overlay.hpp"
+#include "nested_partition.hpp"
+#include "warm_up.hpp"
+
+using namespace fhamonic::melon;
+
+auto generate_queries(const static_digraph & graph,
+                      const std::size_t nb_queries) {
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<vertex_t<static_digraph>> vertex_dist(
+        0, static_cast<vertex_t<static_digraph>>(graph.nb_vertices() - 1));
+    std::vector<std::pair<vertex_t<static_digraph>, vertex_t<static_digraph>>>
+        queries;
+    for(std::size_t i = 0; i < nb_queries; ++i)
+        queries.emplace_back(vertex_dist(rng), vertex_dist(rng));
+    return queries;
+}
+
+int main() {
+    std::vector<std::filesystem::path> gr_files(
+        {"data/9th_DIMACS_USA_roads/time/USA-road-t.NY.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.BAY.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.COL.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.FLA.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NW.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NE.gr"});
+    const std::vector<std::size_t> max_cell_sizes(
+        {1 << 8, 1 << 11, 1 << 14, 1 << 17});
+    std::vector<std::size_t> threads_counts({1, 2, 4, 8, 16});
+    const std::size_t nb_queries = 200;
+
+    std::cout << "instance,nb_nodes,nb_arcs,nb_levels,boundary_vertices,"
+                 "clique_arcs,partition_time_ms,nb_threads,"
+                 "customization_time_ms,query_time_ms,dijkstra_time_ms,"
+                 "speedup,scans_per_query,identical_distances\n";
+
+    (void)warm_up();
+
+    for(const auto & gr_file : gr_files) {
+        auto [graph, length_map] =
+            parse_melon_weighted_digraph<static_digraph, double>(gr_file);
+        const int nb_nodes = graph.nb_vertices();
+        const auto queries = generate_queries(graph, nb_queries);
+
+        Chrono partition_chrono;
+        nested_partition partition(graph, max_cell_sizes);
+        const double partition_time = partition_chrono.timeUs() / 1000.0;
+
+        multilevel_overlay<static_digraph, std::vector<double>> overlay(
+            graph, partition);
+        std::size_t nb_boundary_vertices = 0;
+        for(std::size_t k = 0; k < overlay.nb_levels(); ++k)
+            nb_boundary_vertices += overlay.nb_boundary_vertices(k);
+
+        std::vector<double> customization_times;
+        for(const std::size_t nb_threads : threads_counts) {
+            Chrono chrono;
+            overlay.customize(length_map, nb_threads);
+            customization_times.push_back(chrono.timeUs() / 1000.0);
+        }
+
+        multilevel_dijkstra<static_digraph, std::vector<double>> algo(
+            overlay, length_map);
+        std::vector<double> distances;
+        double nb_scans = 0;
+        Chrono query_chrono;
+        for(auto && [s, t] : queries) {
+            distances.push_back(algo.run(s, t));
+            nb_scans += static_cast<double>(algo.nb_scans());
+        }
+        const double avg_query_time =
+            (query_chrono.timeUs() / 1000.0) / nb_queries;
+
+        bool identical = true;
+        Chrono dijkstra_chrono;
+        for(std::size_t i = 0; i < queries.size(); ++i) {
+            const auto [s, t] = queries[i];
+            double dist_t = std::numeric_limits<double>::max();
+            dijkstra reference(graph, length_map);
+            reference.add_source(s);
+            while(!reference.finished()) {
+                auto [u, dist] = reference.current();
+                if(u == t) {
+                    dist_t = dist;
+                    break;
+                }
+                reference.advance();
+            }
+            identical &= (distances[i] == dist_t);
+        }
+        const double avg_dijkstra_time =
+            (dijkstra_chrono.timeUs() / 1000.0) / nb_queries;
+
+        for(std::size_t i = 0; i < threads_counts.size(); ++i) {
+            std::cout << gr_file.stem() << ',' << nb_nodes << ','
+                      << graph.nb_arcs() << ',' << overlay.nb_levels() << ','
+                      << nb_boundary_vertices << ','
+                      << overlay.nb_clique_arcs() << ',' << partition_time
+                      << ',' << threads_counts[i] << ','
+                      << customization_times[i] << ',' << avg_query_time
+                      << ',' << avg_dijkstra_time << ','
+                      << avg_dijkstra_time / avg_query_time << ','
+                      << nb_scans / nb_queries << ',' << identical
+                      << std::endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include <boost/graph/compressed_sparse_row_graph.hpp>
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/page_rank.hpp>
+
+using namespace boost;
+
+#include "chrono.hpp"
+#include "warm_up.hpp"
+
+// bidirectional for page_rank to pull from the in edges
+typedef compressed_sparse_row_graph<bidirectionalS, no_property, no_property>
+    graph_t;
+
+void parse_gr(const std::filesystem::path & file_name, graph_t & graph) {
+    std::vector<std::pair<int, int>> arcs;
+
+    std::ifstream gr_file(file_name);
+
+    int nb_nodes;
+    int nb_arcs;
+    gr_file >> nb_nodes >> nb_arcs;
+
+    int from, to;
+    while(gr_file >> from >> to) {
+        arcs.emplace_back(from, to);
+    }
+    graph = graph_t(edges_are_unsorted_multi_pass, arcs.begin(), arcs.end(),
+                    nb_nodes);
+}
+
+int main() {
+    std::vector<std::filesystem::path> gr_files(
+        {"data/web-Stanford.txt", "data/Amazon0505.txt", "data/WikiTalk.txt"});
+    // BGL has no convergence test nor dangling vertex handling
+    const std::size_t nb_iterations = 20;
+
+    std::cout << "instance,nb_nodes,nb_arcs,nb_iterations,time_ms,"
+                 "ms_per_iteration,gb_per_s\n";
+
+    (void)warm_up();
+
+    for(const auto & gr_file : gr_files) {
+        graph_t graph;
+        parse_gr(gr_file, graph);
+
+        const std::size_t nb_nodes = num_vertices(graph);
+        const std::size_t nb_arcs = num_edges(graph);
+
+        std::vector<double> ranks(nb_nodes);
+        Chrono chrono;
+        graph::page_rank(graph,
+                         make_iterator_property_map(ranks.begin(),
+                                                    get(vertex_index, graph)),
+                         graph::n_iterations(nb_iterations), 0.85);
+        const double time_ms = chrono.timeUs() / 1000.0;
+
+        // same byte count as page_rank::bytes_per_iteration
+        const double bytes =
+            static_cast<double>(nb_nodes * (sizeof(std::size_t) +
+                                            3 * sizeof(double)) +
+                                nb_arcs * sizeof(std::uint32_t));
+        const double ms_per_iteration =
+            time_ms / static_cast<double>(nb_iterations);
+        std::cout << gr_file.stem() << ',' << nb_nodes << ',' << nb_arcs
+                  << ',' << nb_iterations << ',' << time_ms << ','
+                  << ms_per_iteration << ','
+                  << bytes / (ms_per_iteration * 1e6) << std::endl;
+    }
+    return 0;
+}
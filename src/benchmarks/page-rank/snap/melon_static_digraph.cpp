@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "chrono.hpp"
+
+#include "melon/container/static_digraph.hpp"
+#include "melon/utility/static_digraph_builder.hpp"
+
+#include "page_rank.hpp"
+#include "warm_up.hpp"
+
+using namespace fhamonic::melon;
+
+auto parse_gr(const std::filesystem::path & file_name) {
+    std::ifstream gr_file(file_name);
+    std::size_t nb_nodes, nb_arcs;
+    gr_file >> nb_nodes >> nb_arcs;
+
+    static_digraph_builder<static_digraph> builder(nb_nodes);
+
+    vertex_t<static_digraph> from, to;
+    while(gr_file >> from >> to) builder.add_arc(from, to);
+
+    return builder.build();
+}
+
+// Runs the kernel with each thread count, the first sequential run giving
+// the reference ranks when reference is empty
+template <page_rank_kernel Kernel>
+void benchmark_kernel(const std::filesystem::path & gr_file,
+                      const static_digraph & graph, const std::string & name,
+                      const std::vector<std::size_t> & nb_threads_list,
+                      std::vector<double> & reference) {
+    const double tolerance = 1e-9;
+    const std::size_t max_iterations = 100;
+    for(const std::size_t nb_threads : nb_threads_list) {
+        page_rank<static_digraph, Kernel> pr(graph, 0.85, nb_threads);
+        Chrono chrono;
+        pr.run(tolerance, max_iterations);
+        const double time_ms = chrono.timeUs() / 1000.0;
+
+        if(reference.empty())
+            for(auto && u : graph.vertices()) reference.push_back(pr.rank(u));
+        double max_difference = 0.0;
+        for(auto && u : graph.vertices())
+            max_difference =
+                std::max(max_difference, std::abs(pr.rank(u) - reference[u]));
+
+        const double ms_per_iteration =
+            time_ms / static_cast<double>(pr.nb_iterations());
+        std::cout << gr_file.stem() << ',' << graph.nb_vertices() << ','
+                  << graph.nb_arcs() << ',' << name << ',' << nb_threads
+                  << ',' << pr.nb_iterations() << ',' << time_ms << ','
+                  << ms_per_iteration << ','
+                  << static_cast<double>(pr.bytes_per_iteration()) /
+                         (ms_per_iteration * 1e6)
+                  << ',' << pr.l1_delta() << ',' << max_difference
+                  << std::endl;
+    }
+}
+
+int main() {
+    std::vector<std::filesystem::path> gr_files(
+        {"data/web-Stanford.txt", "data/Amazon0505.txt", "data/WikiTalk.txt"});
+    const std::vector<std::size_t> nb_threads_list = {1, 2, 4, 8, 16};
+
+    std::cout << "instance,nb_nodes,nb_arcs,kernel,nb_threads,nb_iterations,"
+                 "time_ms,ms_per_iteration,gb_per_s,l1_delta,"
+                 "max_rank_difference\n";
+
+    (void)warm_up();
+
+    for(const auto & gr_file : gr_files) {
+        auto [graph] = parse_gr(gr_file);
+
+        std::vector<double> reference;
+        benchmark_kernel<page_rank_kernel::pull>(gr_file, graph, "pull",
+                                                 nb_threads_list, reference);
+        benchmark_kernel<page_rank_kernel::push>(gr_file, graph, "push",
+                                                 nb_threads_list, reference);
+        benchmark_kernel<page_rank_kernel::propagation_blocking>(
+            gr_file, graph, "propagation_blocking", nb_threads_list,
+            reference);
+    }
+    return 0;
+}
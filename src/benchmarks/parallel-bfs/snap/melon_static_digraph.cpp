@@ -0,0 +1,103 @@
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "chrono.hpp"
+
+#include "melon/algorithm/breadth_first_search.hpp"
+#include "melon/container/static_digraph.hpp"
+#include "melon/utility/static_digraph_builder.hpp"
+
+#include "parallel_bfs.hpp"
+#include "warm_up.hpp"
+
+using namespace fhamonic::melon;
+
+auto parse_gr(const std::filesystem::path & file_name) {
+    std::ifstream gr_file(file_name);
+    std::size_t nb_nodes, nb_arcs;
+    gr_file >> nb_nodes >> nb_arcs;
+
+    static_digraph_builder<static_digraph> builder(nb_nodes);
+
+    vertex_t<static_digraph> from, to;
+    while(gr_file >> from >> to) builder.add_arc(from, to);
+
+    return builder.build();
+}
+
+int main() {
+    std::vector<std::filesystem::path> gr_files(
+        {"data/web-Stanford.txt", "data/Amazon0505.txt", "data/WikiTalk.txt"});
+    const std::vector<std::size_t> nb_threads_list = {1, 2, 4, 8, 16};
+    const int nb_sources = 100;
+
+    std::cout << "instance,nb_nodes,nb_arcs,nb_threads,time_ms,"
+                 "sequential_time_ms,speedup,identical_levels\n";
+
+    (void)warm_up();
+
+    for(const auto & gr_file : gr_files) {
+        auto [graph] = parse_gr(gr_file);
+        const int nb_nodes = graph.nb_vertices();
+
+        std::vector<std::unique_ptr<parallel_bfs<static_digraph>>> bfs_list;
+        for(const std::size_t nb_threads : nb_threads_list)
+            bfs_list.push_back(std::make_unique<parallel_bfs<static_digraph>>(
+                graph, nb_threads));
+        std::vector<double> avg_times(nb_threads_list.size(), 0);
+        std::vector<char> identical(nb_threads_list.size(), true);
+
+        constexpr auto unreached = parallel_bfs<static_digraph>::unreached;
+        std::vector<std::uint32_t> level_map(nb_nodes);
+        std::vector<vertex_t<static_digraph>> order;
+        double sequential_time = 0;
+        for(int i = 0; i < nb_sources; ++i) {
+            const auto s = static_cast<vertex_t<static_digraph>>(
+                i * (nb_nodes / nb_sources));
+            Chrono chrono;
+            int sum = 0;
+            breadth_first_search bfs(graph);
+            bfs.add_source(s);
+            for(const auto & u : bfs) sum += u;
+            sequential_time += chrono.timeUs() / 1000.0;
+
+            // melon's BFS visits the vertices by nondecreasing levels, from
+            // which the reference levels are recovered in an untimed search
+            order.clear();
+            breadth_first_search reference(graph);
+            reference.add_source(s);
+            for(const auto & u : reference) order.push_back(u);
+            std::fill(level_map.begin(), level_map.end(), unreached);
+            level_map[s] = 0;
+            for(const auto u : order)
+                for(auto && a : graph.out_arcs(u))
+                    if(level_map[graph.arc_target(a)] == unreached)
+                        level_map[graph.arc_target(a)] = level_map[u] + 1;
+
+            for(std::size_t j = 0; j < bfs_list.size(); ++j) {
+                Chrono parallel_chrono;
+                bfs_list[j]->run(s);
+                avg_times[j] += parallel_chrono.timeUs() / 1000.0;
+                for(auto && u : graph.vertices())
+                    identical[j] &= (bfs_list[j]->reached(u)
+                                         ? bfs_list[j]->level(u)
+                                         : unreached) == level_map[u];
+            }
+        }
+        sequential_time /= nb_sources;
+
+        for(std::size_t j = 0; j < bfs_list.size(); ++j) {
+            const double avg_time = avg_times[j] / nb_sources;
+            std::cout << gr_file.stem() << ',' << nb_nodes << ','
+                      << graph.nb_arcs() << ',' << nb_threads_list[j] << ','
+                      << avg_time << ',' << sequential_time << ','
+                      << sequential_time / avg_time << ','
+                      << bool(identical[j]) << std::endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,173 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+
+#include <boost/graph/compressed_sparse_row_graph.hpp>
+#include <boost/graph/dijkstra_shortest_paths_no_color_map.hpp>
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/visitors.hpp>
+
+using namespace boost;
+
+#include "chrono.hpp"
+#include "warm_up.hpp"
+
+struct Edge_Cost {
+    double weight;
+    Edge_Cost() {}
+    Edge_Cost(double w) : weight(w) {}
+};
+typedef compressed_sparse_row_graph<directedS, no_property, Edge_Cost> graph_t;
+typedef graph_traits<graph_t>::vertex_descriptor vertex_descriptor;
+typedef graph_traits<graph_t>::edge_descriptor edge_descriptor;
+typedef std::pair<int, int> Edge;
+
+void parse_gr(const std::filesystem::path & file_name, graph_t & graph,
+              std::vector<Edge_Cost> & weights) {
+    int nb_nodes;
+    int nb_arcs;
+    std::vector<std::pair<int, int>> arcs;
+    weights.resize(0);
+
+    std::ifstream gr_file(file_name);
+    std::string line;
+    while(getline(gr_file, line)) {
+        std::istringstream iss(line);
+        char ch;
+        if(iss >> ch) {
+            switch(ch) {
+                case 'c':
+                    break;
+                case 'p': {
+                    std::string format;
+                    iss >> format >> nb_nodes >> nb_arcs;
+                    break;
+                }
+                case 'a': {
+                    int from, to;
+                    double length;
+                    if(iss >> from >> to >> length) {
+                        arcs.emplace_back(from - 1, to - 1);
+                        weights.emplace_back(length);
+                    }
+                    break;
+                }
+                default:
+                    std::cerr << "Error in reading " << file_name << std::endl;
+                    std::abort();
+            }
+        }
+    }
+
+    graph = graph_t(edges_are_unsorted_multi_pass, arcs.begin(), arcs.end(),
+                    weights.data(), nb_nodes);
+}
+
+int main() {
+    std::vector<std::filesystem::path> gr_files(
+        {"data/9th_DIMACS_USA_roads/distance/USA-road-d.NY.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NY.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.BAY.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.BAY.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.COL.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.COL.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.FLA.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.FLA.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.NW.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NW.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.NE.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NE.gr"});
+    const std::size_t nb_targets = 64;
+
+    std::cout << "instance,nb_nodes,nb_arcs,time_ms,no_paths_time_ms,"
+                 "tracking_overhead,extraction_time_us,avg_path_length\n";
+
+    (void)warm_up();
+
+    for(const auto & gr_file : gr_files) {
+        graph_t graph;
+        std::vector<Edge_Cost> length_map;
+        parse_gr(gr_file, graph, length_map);
+
+        const int nb_nodes = num_vertices(graph);
+        const int nb_iterations = 30000.0 * 1000.0 / nb_nodes;
+        std::mt19937 rng(1234);
+        std::uniform_int_distribution<vertex_descriptor> vertex_dist(
+            0, static_cast<vertex_descriptor>(nb_nodes - 1));
+        auto weight_map = get(&Edge_Cost::weight, graph);
+
+        // reused by every extraction
+        std::vector<vertex_descriptor> path_vertices;
+        std::vector<edge_descriptor> path_edges;
+
+        double no_paths_time = 0;
+        double paths_time = 0;
+        double extraction_time = 0;
+        std::size_t nb_paths = 0;
+        std::size_t sum_path_lengths = 0;
+        double sum = 0;
+        int iterations = 0;
+        graph_traits<graph_t>::vertex_iterator si, send;
+        for(tie(si, send) = vertices(graph); si != send; ++si) {
+            vertex_descriptor s = *si;
+
+            Chrono no_paths_chrono;
+            std::vector<double> no_paths_d(nb_nodes);
+            dijkstra_shortest_paths_no_color_map(
+                graph, s, distance_map(&no_paths_d[0]).weight_map(weight_map));
+            no_paths_time += no_paths_chrono.timeUs() / 1000.0;
+
+            // the predecessor map of BGL stores vertices, the predecessor
+            // edges are recorded by a visitor as for the other libraries
+            Chrono paths_chrono;
+            std::vector<double> d(nb_nodes);
+            std::vector<edge_descriptor> pred_edges(nb_nodes);
+            dijkstra_shortest_paths_no_color_map(
+                graph, s,
+                distance_map(&d[0]).weight_map(weight_map).visitor(
+                    make_dijkstra_visitor(record_edge_predecessors(
+                        &pred_edges[0], on_edge_relaxed()))));
+            paths_time += paths_chrono.timeUs() / 1000.0;
+
+            Chrono extraction_chrono;
+            for(std::size_t i = 0; i < nb_targets; ++i) {
+                const vertex_descriptor t = vertex_dist(rng);
+                if(d[t] == std::numeric_limits<double>::max()) continue;
+                path_vertices.clear();
+                path_edges.clear();
+                path_vertices.push_back(t);
+                for(vertex_descriptor u = t; u != s;) {
+                    const edge_descriptor e = pred_edges[u];
+                    u = source(e, graph);
+                    path_edges.push_back(e);
+                    path_vertices.push_back(u);
+                }
+                std::reverse(path_vertices.begin(), path_vertices.end());
+                std::reverse(path_edges.begin(), path_edges.end());
+                for(auto && e : path_edges) sum += weight_map[e];
+                sum_path_lengths += path_edges.size();
+                ++nb_paths;
+            }
+            extraction_time += extraction_chrono.timeUs() / 1000.0;
+
+            ++iterations;
+            if(iterations >= nb_iterations) break;
+        }
+
+        std::cout << gr_file.stem() << ',' << nb_nodes << ','
+                  << num_edges(graph) << ','
+                  << (paths_time + extraction_time) / iterations << ','
+                  << no_paths_time / iterations << ','
+                  << paths_time / no_paths_time - 1.0 << ','
+                  << extraction_time * 1000.0 / static_cast<double>(nb_paths)
+                  << ','
+                  << static_cast<double>(sum_path_lengths) /
+                         static_cast<double>(nb_paths)
+                  << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,204 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+#include <lemon/dfs.h>
+#include <lemon/list_graph.h>
+#include <lemon/smart_graph.h>
+#include <lemon/static_graph.h>
+
+#include <lemon/bfs.h>
+#include <lemon/dheap.h>
+#include <lemon/dijkstra.h>
+#include <lemon/maps.h>
+#include <lemon/quad_heap.h>
+
+#include "chrono.hpp"
+#include "warm_up.hpp"
+
+using namespace lemon;
+
+template <typename GR, typename LEN>
+struct DijkstraTraits {
+    typedef GR Digraph;
+    typedef LEN LengthMap;
+    typedef typename LEN::Value Value;
+    typedef DijkstraDefaultOperationTraits<Value> OperationTraits;
+    typedef typename Digraph::template NodeMap<int> HeapCrossRef;
+    static HeapCrossRef * createHeapCrossRef(const Digraph & g) {
+        return new HeapCrossRef(g);
+    }
+
+    // typedef BinHeap<typename LEN::Value, HeapCrossRef, std::less<Value>>
+    // Heap; typedef QuadHeap<typename LEN::Value, HeapCrossRef,
+    // std::less<Value>> Heap;
+    typedef DHeap<typename LEN::Value, HeapCrossRef, 2, std::less<Value>> Heap;
+    static Heap * createHeap(HeapCrossRef & r) { return new Heap(r); }
+
+    typedef typename Digraph::template NodeMap<typename Digraph::Arc> PredMap;
+    static PredMap * createPredMap(const Digraph & g) { return new PredMap(g); }
+
+    typedef NullMap<typename Digraph::Node, bool> ProcessedMap;
+    static ProcessedMap * createProcessedMap(const Digraph &) {
+        return new ProcessedMap();
+    }
+
+    typedef typename Digraph::template NodeMap<typename LEN::Value> DistMap;
+    static DistMap * createDistMap(const Digraph & g) { return new DistMap(g); }
+};
+
+template <typename GR, typename LEN>
+struct NoPathsDijkstraTraits : DijkstraTraits<GR, LEN> {
+    typedef NullMap<typename GR::Node, typename GR::Arc> PredMap;
+    static PredMap * createPredMap(const GR &) { return new PredMap(); }
+};
+
+struct arc_entry {
+    int first;
+    int second;
+    double weight;
+    arc_entry(int u, int v, double l) : first(u), second(v), weight(l) {}
+};
+std::unique_ptr<StaticDigraph::ArcMap<double>> parse_gr(
+    const std::filesystem::path & file_name, StaticDigraph & graph) {
+    std::vector<arc_entry> arcs;
+    std::string format;
+    int nb_nodes, nb_arcs;
+
+    std::ifstream gr_file(file_name);
+    std::string line;
+    while(getline(gr_file, line)) {
+        std::istringstream iss(line);
+        char ch;
+        if(iss >> ch) {
+            switch(ch) {
+                case 'c':
+                    break;
+                case 'p': {
+                    iss >> format >> nb_nodes >> nb_arcs;
+                    break;
+                }
+                case 'a': {
+                    int from, to;
+                    double length;
+                    if(iss >> from >> to >> length) {
+                        arcs.emplace_back(from - 1, to - 1, length);
+                    }
+                    break;
+                }
+                default:
+                    std::cerr << "Error in reading " << file_name << std::endl;
+                    std::abort();
+            }
+        }
+    }
+
+    std::sort(arcs.begin(), arcs.end(), [](const auto & a, const auto & b) {
+        if(a.first == b.first) return a.second < b.second;
+        return a.first < b.first;
+    });
+    graph.build(nb_nodes, arcs.begin(), arcs.end());
+    auto length_map = std::make_unique<StaticDigraph::ArcMap<double>>(graph);
+    for(std::size_t i = 0; i < nb_arcs; ++i) {
+        (*length_map)[graph.arcFromId(i)] = arcs[i].weight;
+    }
+    return std::move(length_map);
+}
+
+int main() {
+    std::vector<std::filesystem::path> gr_files(
+        {"data/9th_DIMACS_USA_roads/distance/USA-road-d.NY.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NY.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.BAY.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.BAY.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.COL.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.COL.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.FLA.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.FLA.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.NW.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NW.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.NE.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NE.gr"});
+    const std::size_t nb_targets = 64;
+
+    std::cout << "instance,nb_nodes,nb_arcs,time_ms,no_paths_time_ms,"
+                 "tracking_overhead,extraction_time_us,avg_path_length\n";
+
+    (void)warm_up();
+
+    for(const auto & gr_file : gr_files) {
+        using Graph = StaticDigraph;
+        using LengthMap = Graph::ArcMap<double>;
+        StaticDigraph graph;
+        std::unique_ptr<LengthMap> length_map = parse_gr(gr_file, graph);
+
+        const int nb_nodes = countNodes(graph);
+        const int nb_iterations = 30000.0 * 1000.0 / nb_nodes;
+        std::mt19937 rng(1234);
+        std::uniform_int_distribution<int> node_dist(0, nb_nodes - 1);
+
+        // reused by every extraction
+        std::vector<Graph::Node> path_nodes;
+        std::vector<Graph::Arc> path_arcs;
+
+        double no_paths_time = 0;
+        double paths_time = 0;
+        double extraction_time = 0;
+        std::size_t nb_paths = 0;
+        std::size_t sum_path_lengths = 0;
+        double sum = 0;
+        int iterations = 0;
+        for(int i = 0; i < nb_iterations && i < nb_nodes; ++i) {
+            Graph::Node s = graph.nodeFromId(i);
+
+            Chrono no_paths_chrono;
+            Dijkstra<Graph, LengthMap, NoPathsDijkstraTraits<Graph, LengthMap>>
+                no_paths_dijkstra(graph, *length_map);
+            no_paths_dijkstra.run(s);
+            no_paths_time += no_paths_chrono.timeUs() / 1000.0;
+
+            Chrono paths_chrono;
+            Dijkstra<Graph, LengthMap, DijkstraTraits<Graph, LengthMap>>
+                dijkstra(graph, *length_map);
+            dijkstra.run(s);
+            paths_time += paths_chrono.timeUs() / 1000.0;
+
+            Chrono extraction_chrono;
+            for(std::size_t j = 0; j < nb_targets; ++j) {
+                const Graph::Node t = graph.nodeFromId(node_dist(rng));
+                if(!dijkstra.reached(t)) continue;
+                path_nodes.clear();
+                path_arcs.clear();
+                path_nodes.push_back(t);
+                for(Graph::Arc a = dijkstra.predArc(t); a != INVALID;
+                    a = dijkstra.predArc(graph.source(a))) {
+                    path_arcs.push_back(a);
+                    path_nodes.push_back(graph.source(a));
+                }
+                std::reverse(path_nodes.begin(), path_nodes.end());
+                std::reverse(path_arcs.begin(), path_arcs.end());
+                for(auto && a : path_arcs) sum += (*length_map)[a];
+                sum_path_lengths += path_arcs.size();
+                ++nb_paths;
+            }
+            extraction_time += extraction_chrono.timeUs() / 1000.0;
+
+            ++iterations;
+        }
+
+        std::cout << gr_file.stem() << ',' << nb_nodes << ','
+                  << countArcs(graph) << ','
+                  << (paths_time + extraction_time) / iterations << ','
+                  << no_paths_time / iterations << ','
+                  << paths_time / no_paths_time - 1.0 << ','
+                  << extraction_time * 1000.0 / static_cast<double>(nb_paths)
+                  << ','
+                  << static_cast<double>(sum_path_lengths) /
+                         static_cast<double>(nb_paths)
+                  << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "melon/algorithm/dijkstra.hpp"
+#include "melon/container/static_digraph.hpp"
+
+#include "chrono.hpp"
+#include "melon_parsers.hpp"
+#include "warm_up.hpp"
+
+using namespace fhamonic::melon;
+
+struct dijkstra_traits {
+    using semiring = shortest_path_semiring<double>;
+    using heap = d_ary_heap<2, vertex_t<static_digraph>, double,
+                            decltype([](const auto & e1, const auto & e2) {
+                                return semiring::less(e1.second, e2.second);
+                            }),
+                            vertex_map_t<static_digraph, std::size_t>>;
+
+    static constexpr bool store_paths = false;
+    static constexpr bool store_distances = true;
+};
+
+struct paths_dijkstra_traits : dijkstra_traits {
+    static constexpr bool store_paths = true;
+};
+
+int main() {
+    std::vector<std::filesystem::path> gr_files(
+        {"data/9th_DIMACS_USA_roads/distance/USA-road-d.NY.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NY.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.BAY.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.BAY.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.COL.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.COL.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.FLA.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.FLA.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.NW.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NW.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.NE.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NE.gr"});
+    const std::size_t nb_targets = 64;
+
+    std::cout << "instance,nb_nodes,nb_arcs,time_ms,no_paths_time_ms,"
+                 "tracking_overhead,extraction_time_us,avg_path_length\n";
+
+    (void)warm_up();
+
+    for(const auto & gr_file : gr_files) {
+        auto [graph, length_map] =
+            parse_melon_weighted_digraph<static_digraph, double>(gr_file);
+
+        const int nb_nodes = graph.nb_vertices();
+        const int nb_iterations = 30000.0 * 1000.0 / nb_nodes;
+        std::mt19937 rng(1234);
+        std::uniform_int_distribution<vertex_t<static_digraph>> vertex_dist(
+            0, static_cast<vertex_t<static_digraph>>(nb_nodes - 1));
+
+        // reused by every extraction
+        std::vector<vertex_t<static_digraph>> path_vertices;
+        std::vector<arc_t<static_digraph>> path_arcs;
+
+        double no_paths_time = 0;
+        double paths_time = 0;
+        double extraction_time = 0;
+        std::size_t nb_paths = 0;
+        std::size_t sum_path_lengths = 0;
+        double sum = 0;
+        int iterations = 0;
+        for(auto && s : graph.vertices()) {
+            Chrono no_paths_chrono;
+            dijkstra no_paths_algo(dijkstra_traits{}, graph, length_map, s);
+            no_paths_algo.run();
+            no_paths_time += no_paths_chrono.timeUs() / 1000.0;
+
+            Chrono paths_chrono;
+            dijkstra algo(paths_dijkstra_traits{}, graph, length_map, s);
+            algo.run();
+            paths_time += paths_chrono.timeUs() / 1000.0;
+
+            Chrono extraction_chrono;
+            for(std::size_t i = 0; i < nb_targets; ++i) {
+                const auto t = vertex_dist(rng);
+                if(!algo.reached(t)) continue;
+                path_vertices.clear();
+                path_arcs.clear();
+                path_vertices.push_back(t);
+                for(auto u = t; u != s;) {
+                    const auto a = algo.pred_arc(u);
+                    u = graph.arc_source(a);
+                    path_arcs.push_back(a);
+                    path_vertices.push_back(u);
+                }
+                std::reverse(path_vertices.begin(), path_vertices.end());
+                std::reverse(path_arcs.begin(), path_arcs.end());
+                for(auto && a : path_arcs) sum += length_map[a];
+                sum_path_lengths += path_arcs.size();
+                ++nb_paths;
+            }
+            extraction_time += extraction_chrono.timeUs() / 1000.0;
+
+            ++iterations;
+            if(iterations >= nb_iterations) break;
+        }
+
+        std::cout << gr_file.stem() << ',' << nb_nodes << ',' << graph.nb_arcs()
+                  << ',' << (paths_time + extraction_time) / iterations << ','
+                  << no_paths_time / iterations << ','
+                  << paths_time / no_paths_time - 1.0 << ','
+                  << extraction_time * 1000.0 / static_cast<double>(nb_paths)
+                  << ','
+                  << static_cast<double>(sum_path_lengths) /
+                         static_cast<double>(nb_paths)
+                  << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,102 @@
+#include <array>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <type_traits>
+
+#include "melon/algorithm/dijkstra.hpp"
+#include "melon/container/static_digraph.hpp"
+
+#include "chrono.hpp"
+#include "contraction_hierarchy.hpp"
+#include "melon_parsers.hpp"
+#include "phast.hpp"
+#include "warm_up.hpp"
+
+using namespace fhamonic::melon;
+
+using hierarchy = contraction_hierarchy<static_digraph, std::vector<double>>;
+
+template <std::size_t K>
+void benchmark_phast(const std::filesystem::path & gr_file,
+                     const static_digraph & graph,
+                     const std::vector<double> & length_map,
+                     const hierarchy & ch, const double preprocessing_time) {
+    const int nb_nodes = graph.nb_vertices();
+    const int nb_batches = 3000.0 * 1000.0 / nb_nodes / K + 1;
+
+    phast<static_digraph, std::vector<double>, K> algo(ch);
+    double avg_batch_time = 0;
+    double avg_dijkstra_time = 0;
+    bool identical = true;
+    std::vector<double> distances(nb_nodes);
+    vertex_t<static_digraph> s = 0;
+    for(int batch = 0; batch < nb_batches; ++batch) {
+        std::array<vertex_t<static_digraph>, K> sources;
+        for(auto & source : sources) source = s++ % nb_nodes;
+
+        Chrono chrono;
+        algo.run(sources);
+        avg_batch_time += (chrono.timeUs() / 1000.0);
+
+        for(std::size_t i = 0; i < K; ++i) {
+            std::fill(distances.begin(), distances.end(),
+                      std::numeric_limits<double>::max());
+            Chrono dijkstra_chrono;
+            for(auto && [u, dist] : dijkstra(graph, length_map, sources[i])) {
+                distances[u] = dist;
+            }
+            avg_dijkstra_time += (dijkstra_chrono.timeUs() / 1000.0);
+
+            for(auto && u : graph.vertices())
+                identical &= (algo.dist(i, u) == distances[u]);
+        }
+    }
+    avg_batch_time /= nb_batches;
+    avg_dijkstra_time /= nb_batches * K;
+
+    std::cout << gr_file.stem() << ',' << nb_nodes << ',' << graph.nb_arcs()
+              << ',' << ch.nb_shortcuts() << ',' << preprocessing_time << ','
+              << K << ',' << avg_batch_time << ',' << avg_batch_time / K
+              << ',' << avg_dijkstra_time << ','
+              << avg_dijkstra_time * K / avg_batch_time << ',' << identical
+              << std::endl;
+}
+
+int main() {
+    std::vector<std::filesystem::path> gr_files(
+        {"data/9th_DIMACS_USA_roads/distance/USA-road-d.NY.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NY.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.BAY.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.BAY.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.COL.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.COL.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.FLA.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.FLA.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.NW.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NW.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.NE.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NE.gr"});
+
+    std::cout << "instance,nb_nodes,nb_arcs,nb_shortcuts,preprocessing_time_ms,"
+                 "nb_sources,batch_time_ms,time_per_source_ms,"
+                 "dijkstra_time_per_source_ms,speedup,identical_distances\n";
+
+    (void)warm_up();
+
+    for(const auto & gr_file : gr_files) {
+        auto [graph, length_map] =
+            parse_melon_weighted_digraph<static_digraph, double>(gr_file);
+
+        Chrono chrono;
+        hierarchy ch(graph, length_map);
+        const double preprocessing_time = chrono.timeUs() / 1000.0;
+
+        benchmark_phast<1>(gr_file, graph, length_map, ch, preprocessing_time);
+        benchmark_phast<4>(gr_file, graph, length_map, ch, preprocessing_time);
+        benchmark_phast<8>(gr_file, graph, length_map, ch, preprocessing_time);
+        benchmark_phast<16>(gr_file, graph, length_map, ch,
+                            preprocessing_time);
+    }
+    return 0;
+}
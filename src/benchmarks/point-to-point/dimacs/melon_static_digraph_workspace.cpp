@@ -0,0 +1,103 @@
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <type_traits>
+
+#include "melon/algorithm/dijkstra.hpp"
+#include "melon/container/static_digraph.hpp"
+
+#include "chrono.hpp"
+#include "dijkstra_workspace.hpp"
+#include "melon_parsers.hpp"
+#include "warm_up.hpp"
+
+using namespace fhamonic::melon;
+
+struct dijkstra_traits {
+    using semiring = shortest_path_semiring<double>;
+    using heap = d_ary_heap<2, vertex_t<static_digraph>, double,
+                            decltype([](const auto & e1, const auto & e2) {
+                                return semiring::less(e1.second, e2.second);
+                            }),
+                            vertex_map_t<static_digraph, std::size_t>>;
+
+    static constexpr bool store_paths = false;
+    static constexpr bool store_distances = false;
+};
+
+// Targets are taken at a fixed Dijkstra rank from random sources, so that
+// the early terminated searches stay small whatever the graph size
+auto generate_queries(const static_digraph & graph,
+                      const std::vector<double> & length_map,
+                      const std::size_t nb_queries,
+                      const std::size_t dijkstra_rank) {
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<vertex_t<static_digraph>> vertex_dist(
+        0, static_cast<vertex_t<static_digraph>>(graph.nb_vertices() - 1));
+    std::vector<std::pair<vertex_t<static_digraph>, vertex_t<static_digraph>>>
+        queries;
+    for(std::size_t i = 0; i < nb_queries; ++i) {
+        const auto s = vertex_dist(rng);
+        auto t = s;
+        std::size_t rank = 0;
+        for(auto && [u, dist] : dijkstra(graph, length_map, s)) {
+            t = u;
+            if(++rank >= dijkstra_rank) break;
+        }
+        queries.emplace_back(s, t);
+    }
+    return queries;
+}
+
+int main() {
+    std::vector<std::filesystem::path> gr_files(
+        {"data/rome99.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.NY.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NY.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.BAY.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.BAY.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.COL.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.COL.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.FLA.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.FLA.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.NW.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NW.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.NE.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NE.gr"});
+    const std::size_t nb_queries = 10000;
+    const std::size_t dijkstra_rank = 1 << 10;
+
+    std::cout << "instance,nb_nodes,nb_arcs,time_ms\n";
+
+    (void)warm_up();
+
+    for(const auto & gr_file : gr_files) {
+        auto [graph, length_map] =
+            parse_melon_weighted_digraph<static_digraph, double>(gr_file);
+        const auto queries =
+            generate_queries(graph, length_map, nb_queries, dijkstra_rank);
+
+        dijkstra_workspace workspace(dijkstra_traits{}, graph, length_map);
+
+        const int nb_nodes = graph.nb_vertices();
+        double sum = 0;
+        Chrono chrono;
+        for(auto && [s, t] : queries) {
+            workspace.reset();
+            workspace.add_source(s);
+            while(!workspace.finished()) {
+                auto [u, dist] = workspace.current();
+                if(u == t) {
+                    sum += dist;
+                    break;
+                }
+                workspace.advance();
+            }
+        }
+        double avg_time = (chrono.timeUs() / 1000.0) / nb_queries;
+
+        std::cout << gr_file.stem() << ',' << nb_nodes << ',' << graph.nb_arcs()
+                  << ',' << avg_time << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "melon/algorithm/dijkstra.hpp"
+#include "melon/container/static_digraph.hpp"
+
+#include "chrono.hpp"
+#include "melon_parsers.hpp"
+#include "piecewise_linear_functions.hpp"
+#include "time_dependent_dijkstra.hpp"
+#include "warm_up.hpp"
+
+using namespace fhamonic::melon;
+
+struct dijkstra_traits {
+    using semiring = shortest_path_semiring<double>;
+    using heap = d_ary_heap<2, vertex_t<static_digraph>, double,
+                            decltype([](const auto & e1, const auto & e2) {
+                                return semiring::less(e1.second, e2.second);
+                            }),
+                            vertex_map_t<static_digraph, std::size_t>>;
+
+    static constexpr bool store_paths = false;
+    static constexpr bool store_distances = false;
+};
+
+int main() {
+    std::vector<std::filesystem::path> gr_files(
+        {"data/9th_DIMACS_USA_roads/time/USA-road-t.NY.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.BAY.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.COL.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.FLA.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NW.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NE.gr"});
+    const std::vector<std::size_t> breakpoints_counts = {4, 16, 64};
+    const double congested_ratio = 0.3;
+    // one day, assuming travel times in tenths of a second
+    const double period = 24.0 * 3600.0 * 10.0;
+
+    std::cout << "instance,nb_nodes,nb_arcs,nb_breakpoints,static_time_ms,"
+                 "td_time_ms,slowdown,static_memory_mb,td_memory_mb\n";
+
+    (void)warm_up();
+
+    for(const auto & gr_file : gr_files) {
+        auto [graph, length_map] =
+            parse_melon_weighted_digraph<static_digraph, double>(gr_file);
+
+        const int nb_nodes = graph.nb_vertices();
+        const int nb_iterations = 30000.0 * 1000.0 / nb_nodes;
+        for(const std::size_t nb_breakpoints : breakpoints_counts) {
+            const piecewise_linear_functions functions =
+                generate_travel_time_profiles(graph, length_map,
+                                              nb_breakpoints, congested_ratio,
+                                              period);
+            time_dependent_dijkstra td_dijkstra(dijkstra_traits{}, graph,
+                                                functions);
+            std::mt19937 rng(1234);
+            std::uniform_real_distribution<double> departure_dist(0.0, period);
+
+            double static_time = 0;
+            double td_time = 0;
+            double sum = 0;
+            int iterations = 0;
+            for(auto && s : graph.vertices()) {
+                Chrono static_chrono;
+                for(auto && [u, dist] :
+                    dijkstra(dijkstra_traits{}, graph, length_map, s)) {
+                    sum += dist;
+                }
+                static_time += static_chrono.timeUs() / 1000.0;
+
+                const double departure = departure_dist(rng);
+                Chrono td_chrono;
+                td_dijkstra.reset();
+                td_dijkstra.add_source(s, departure);
+                while(!td_dijkstra.finished()) {
+                    sum += td_dijkstra.current().second - departure;
+                    td_dijkstra.advance();
+                }
+                td_time += td_chrono.timeUs() / 1000.0;
+
+                ++iterations;
+                if(iterations >= nb_iterations) break;
+            }
+
+            std::cout << gr_file.stem() << ',' << nb_nodes << ','
+                      << graph.nb_arcs() << ',' << nb_breakpoints << ','
+                      << static_time / iterations << ','
+                      << td_time / iterations << ',' << td_time / static_time
+                      << ','
+                      << double(graph.nb_arcs() * sizeof(double)) / 1e6 << ','
+                      << double(functions.memory_bytes()) / 1e6 << std::endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include <boost/graph/compressed_sparse_row_graph.hpp>
+#include <boost/graph/depth_first_search.hpp>
+#include <boost/graph/graph_traits.hpp>
+
+using namespace boost;
+
+#include "chrono.hpp"
+#include "warm_up.hpp"
+
+typedef compressed_sparse_row_graph<directedS, no_property, no_property>
+    graph_t;
+typedef graph_traits<graph_t>::vertex_descriptor vertex_descriptor;
+typedef graph_traits<graph_t>::edge_descriptor edge_descriptor;
+
+// Orients every arc from the lower to the higher rank of a random
+// permutation of the vertices, which yields a DAG, and drops self loops
+void parse_dag(const std::filesystem::path & file_name, graph_t & graph) {
+    std::vector<std::pair<int, int>> arcs;
+
+    std::ifstream gr_file(file_name);
+
+    int nb_nodes;
+    int nb_arcs;
+    gr_file >> nb_nodes >> nb_arcs;
+
+    std::vector<std::size_t> rank(nb_nodes);
+    std::iota(rank.begin(), rank.end(), 0);
+    std::shuffle(rank.begin(), rank.end(), std::mt19937(1234));
+
+    int from, to;
+    while(gr_file >> from >> to) {
+        if(from == to) continue;
+        if(rank[from] < rank[to])
+            arcs.emplace_back(from, to);
+        else
+            arcs.emplace_back(to, from);
+    }
+    std::sort(arcs.begin(), arcs.end(), [](const auto & a, const auto & b) {
+        if(a.first == b.first) return a.second < b.second;
+        return a.first < b.first;
+    });
+    graph = graph_t(edges_are_sorted, arcs.begin(), arcs.end(), nb_nodes);
+}
+
+class topological_sort_visitor : public boost::default_dfs_visitor {
+public:
+    std::vector<vertex_descriptor> & order;  // reversed
+    bool & has_cycle;
+    topological_sort_visitor(std::vector<vertex_descriptor> & order,
+                             bool & has_cycle)
+        : order(order), has_cycle(has_cycle) {}
+    void finish_vertex(const vertex_descriptor & u, const graph_t & g) {
+        (void)g;
+        order.push_back(u);
+    }
+    void back_edge(const edge_descriptor & e, const graph_t & g) {
+        (void)e;
+        (void)g;
+        has_cycle = true;
+    }
+};
+
+int main() {
+    std::vector<std::filesystem::path> gr_files(
+        {"data/web-Stanford.txt", "data/Amazon0505.txt", "data/WikiTalk.txt"});
+
+    std::cout << "instance,nb_nodes,nb_arcs,is_topological,time_ms\n";
+
+    (void)warm_up();
+
+    for(const auto & gr_file : gr_files) {
+        graph_t graph;
+        parse_dag(gr_file, graph);
+
+        const int nb_nodes = num_vertices(graph);
+
+        const int nb_runs = 10;
+        double avg_time = 0;
+        std::vector<vertex_descriptor> order;
+        bool has_cycle = false;
+        for(int i = 0; i < nb_runs; ++i) {
+            Chrono chrono;
+            order.clear();
+            order.reserve(nb_nodes);
+            has_cycle = false;
+            topological_sort_visitor vis(order, has_cycle);
+            boost::depth_first_search(graph, visitor(vis));
+            std::reverse(order.begin(), order.end());
+
+            avg_time += (chrono.timeUs() / 1000.0);
+        }
+        avg_time /= nb_runs;
+
+        std::vector<std::size_t> position(nb_nodes);
+        for(std::size_t i = 0; i < order.size(); ++i) position[order[i]] = i;
+        bool is_topological =
+            !has_cycle && static_cast<int>(order.size()) == nb_nodes;
+        graph_traits<graph_t>::edge_iterator ei, eend;
+        for(tie(ei, eend) = edges(graph); ei != eend; ++ei)
+            is_topological &= position[source(*ei, graph)] <
+                              position[target(*ei, graph)];
+
+        std::cout << gr_file.stem() << ',' << nb_nodes << ','
+                  << num_edges(graph) << ',' << is_topological << ','
+                  << avg_time << std::endl;
+    }
+    return 0;
+}
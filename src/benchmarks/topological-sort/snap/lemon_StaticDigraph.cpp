@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include <lemon/static_graph.h>
+
+#include <lemon/dfs.h>
+
+#include "chrono.hpp"
+#include "warm_up.hpp"
+
+using namespace lemon;
+
+// Orients every arc from the lower to the higher rank of a random
+// permutation of the vertices, which yields a DAG, and drops self loops
+void parse_dag(const std::filesystem::path & file_name, StaticDigraph & graph) {
+    std::ifstream gr_file(file_name);
+
+    int nb_nodes, nb_arcs;
+    gr_file >> nb_nodes >> nb_arcs;
+
+    std::vector<std::size_t> rank(nb_nodes);
+    std::iota(rank.begin(), rank.end(), 0);
+    std::shuffle(rank.begin(), rank.end(), std::mt19937(1234));
+
+    std::vector<std::pair<int, int>> arcs;
+    arcs.reserve(nb_arcs);
+    int from, to;
+    while(gr_file >> from >> to) {
+        if(from == to) continue;
+        if(rank[from] < rank[to])
+            arcs.push_back(std::make_pair(from, to));
+        else
+            arcs.push_back(std::make_pair(to, from));
+    }
+    std::sort(arcs.begin(), arcs.end(), [](const auto & a, const auto & b) {
+        if(a.first == b.first) return a.second < b.second;
+        return a.first < b.first;
+    });
+    graph.build(nb_nodes, arcs.begin(), arcs.end());
+}
+
+using Graph = StaticDigraph;
+
+struct TopologicalSortVisitor : public DfsVisitor<Graph> {
+    const Graph & graph;
+    std::vector<Graph::Node> & order;  // reversed
+    Graph::NodeMap<bool> & on_stack;
+    bool & has_cycle;
+
+    TopologicalSortVisitor(const Graph & graph,
+                           std::vector<Graph::Node> & order,
+                           Graph::NodeMap<bool> & on_stack, bool & has_cycle)
+        : graph(graph)
+        , order(order)
+        , on_stack(on_stack)
+        , has_cycle(has_cycle) {}
+
+    void reach(const Graph::Node & u) { on_stack[u] = true; }
+    void leave(const Graph::Node & u) {
+        on_stack[u] = false;
+        order.push_back(u);
+    }
+    // called on the arcs whose target was already reached
+    void examine(const Graph::Arc & a) {
+        if(on_stack[graph.target(a)]) has_cycle = true;
+    }
+};
+
+int main() {
+    std::vector<std::filesystem::path> gr_files(
+        {"data/web-Stanford.txt", "data/Amazon0505.txt", "data/WikiTalk.txt"});
+
+    std::cout << "instance,nb_nodes,nb_arcs,is_topological,time_ms\n";
+
+    (void)warm_up();
+
+    for(const auto & gr_file : gr_files) {
+        Graph graph;
+        parse_dag(gr_file, graph);
+        const int nb_nodes = countNodes(graph);
+
+        const int nb_runs = 10;
+        double avg_time = 0;
+        std::vector<Graph::Node> order;
+        bool has_cycle = false;
+        for(int i = 0; i < nb_runs; ++i) {
+            Chrono chrono;
+            order.clear();
+            order.reserve(nb_nodes);
+            has_cycle = false;
+            Graph::NodeMap<bool> on_stack(graph, false);
+            TopologicalSortVisitor visitor(graph, order, on_stack, has_cycle);
+            DfsVisit<Graph, TopologicalSortVisitor> dfs(graph, visitor);
+            dfs.init();
+            for(Graph::NodeIt u(graph); u != INVALID; ++u) {
+                if(dfs.reached(u)) continue;
+                dfs.addSource(u);
+                dfs.start();
+            }
+            std::reverse(order.begin(), order.end());
+
+            avg_time += (chrono.timeUs() / 1000.0);
+        }
+        avg_time /= nb_runs;
+
+        Graph::NodeMap<int> position(graph);
+        for(std::size_t i = 0; i < order.size(); ++i)
+            position[order[i]] = static_cast<int>(i);
+        bool is_topological =
+            !has_cycle && static_cast<int>(order.size()) == nb_nodes;
+        for(Graph::ArcIt a(graph); a != INVALID; ++a)
+            is_topological &=
+                position[graph.source(a)] < position[graph.target(a)];
+
+        std::cout << gr_file.stem() << ',' << nb_nodes << ','
+                  << countArcs(graph) << ',' << is_topological << ','
+                  << avg_time << std::endl;
+    }
+    return 0;
+}
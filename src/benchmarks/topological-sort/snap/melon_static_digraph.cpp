@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "chrono.hpp"
+
+#include "melon/container/static_digraph.hpp"
+#include "melon/utility/static_digraph_builder.hpp"
+
+#include "timestamped_dfs.hpp"
+#include "warm_up.hpp"
+
+using namespace fhamonic::melon;
+
+using vertex = vertex_t<static_digraph>;
+using arc = arc_t<static_digraph>;
+
+// Orients every arc from the lower to the higher rank of a random
+// permutation of the vertices, which yields a DAG, and drops self loops
+auto parse_dag(const std::filesystem::path & file_name) {
+    std::ifstream gr_file(file_name);
+    std::size_t nb_nodes, nb_arcs;
+    gr_file >> nb_nodes >> nb_arcs;
+
+    std::vector<std::size_t> rank(nb_nodes);
+    std::iota(rank.begin(), rank.end(), 0);
+    std::shuffle(rank.begin(), rank.end(), std::mt19937(1234));
+
+    static_digraph_builder<static_digraph> builder(nb_nodes);
+
+    vertex from, to;
+    while(gr_file >> from >> to) {
+        if(from == to) continue;
+        if(rank[from] < rank[to])
+            builder.add_arc(from, to);
+        else
+            builder.add_arc(to, from);
+    }
+
+    return builder.build();
+}
+
+struct topological_sort_visitor : null_dfs_visitor {
+    std::vector<vertex> order;  // reversed
+    bool has_cycle = false;
+
+    void finish_vertex(const vertex u) { order.push_back(u); }
+    void back_arc(const arc, const vertex, const vertex) { has_cycle = true; }
+};
+
+int main() {
+    std::vector<std::filesystem::path> gr_files(
+        {"data/web-Stanford.txt", "data/Amazon0505.txt", "data/WikiTalk.txt"});
+
+    std::cout << "instance,nb_nodes,nb_arcs,is_topological,time_ms\n";
+
+    (void)warm_up();
+
+    for(const auto & gr_file : gr_files) {
+        auto [graph] = parse_dag(gr_file);
+        const int nb_nodes = graph.nb_vertices();
+
+        const int nb_runs = 10;
+        double avg_time = 0;
+        std::vector<vertex> order;
+        bool has_cycle = false;
+        for(int i = 0; i < nb_runs; ++i) {
+            Chrono chrono;
+            timestamped_dfs dfs(graph, topological_sort_visitor{});
+            dfs.visitor().order.reserve(graph.nb_vertices());
+            dfs.run();
+            order = std::move(dfs.visitor().order);
+            std::reverse(order.begin(), order.end());
+            has_cycle = dfs.visitor().has_cycle;
+
+            avg_time += (chrono.timeUs() / 1000.0);
+        }
+        avg_time /= nb_runs;
+
+        std::vector<std::size_t> position(graph.nb_vertices());
+        for(std::size_t i = 0; i < order.size(); ++i) position[order[i]] = i;
+        bool is_topological =
+            !has_cycle && order.size() == graph.nb_vertices();
+        for(auto && u : graph.vertices())
+            for(auto && v : graph.out_neighbors(u))
+                is_topological &= position[u] < position[v];
+
+        std::cout << gr_file.stem() << ',' << nb_nodes << ',' << graph.nb_arcs()
+                  << ',' << is_topological << ',' << avg_time << std::endl;
+    }
+    return 0;
+}
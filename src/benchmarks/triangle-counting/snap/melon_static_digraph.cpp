@@ -0,0 +1,76 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "chrono.hpp"
+
+#include "melon/container/static_digraph.hpp"
+#include "melon/utility/static_digraph_builder.hpp"
+
+#include "triangle_counting.hpp"
+#include "warm_up.hpp"
+
+using namespace fhamonic::melon;
+
+auto parse_gr(const std::filesystem::path & file_name) {
+    std::ifstream gr_file(file_name);
+    std::size_t nb_nodes, nb_arcs;
+    gr_file >> nb_nodes >> nb_arcs;
+
+    static_digraph_builder<static_digraph> builder(nb_nodes);
+
+    vertex_t<static_digraph> from, to;
+    while(gr_file >> from >> to) builder.add_arc(from, to);
+
+    return builder.build();
+}
+
+// Runs the strategy with each thread count, the construction of the degree
+// ordered DAG being timed apart
+template <intersection_strategy Strategy>
+void benchmark_strategy(const std::filesystem::path & gr_file,
+                        const static_digraph & graph, const std::string & name,
+                        const std::vector<std::size_t> & nb_threads_list) {
+    for(const std::size_t nb_threads : nb_threads_list) {
+        Chrono build_chrono;
+        triangle_counting<static_digraph, Strategy> tc(graph, nb_threads);
+        const double build_time_ms = build_chrono.timeUs() / 1000.0;
+
+        Chrono chrono;
+        tc.run();
+        const double time_ms = chrono.timeUs() / 1000.0;
+
+        std::cout << gr_file.stem() << ',' << graph.nb_vertices() << ','
+                  << graph.nb_arcs() << ',' << tc.nb_edges() << ',' << name
+                  << ',' << nb_threads << ',' << tc.nb_triangles() << ','
+                  << tc.global_clustering_coefficient() << ','
+                  << build_time_ms << ',' << time_ms << std::endl;
+    }
+}
+
+int main() {
+    std::vector<std::filesystem::path> gr_files(
+        {"data/web-Stanford.txt", "data/Amazon0505.txt", "data/WikiTalk.txt"});
+    const std::vector<std::size_t> nb_threads_list = {1, 2, 4, 8, 16};
+
+    std::cout << "instance,nb_nodes,nb_arcs,nb_edges,strategy,nb_threads,"
+                 "nb_triangles,global_clustering,build_time_ms,time_ms\n";
+
+    (void)warm_up();
+
+    for(const auto & gr_file : gr_files) {
+        auto [graph] = parse_gr(gr_file);
+
+        benchmark_strategy<intersection_strategy::merge>(
+            gr_file, graph, "merge", nb_threads_list);
+        benchmark_strategy<intersection_strategy::galloping>(
+            gr_file, graph, "galloping", nb_threads_list);
+        benchmark_strategy<intersection_strategy::simd>(gr_file, graph, "simd",
+                                                        nb_threads_list);
+    }
+    return 0;
+}
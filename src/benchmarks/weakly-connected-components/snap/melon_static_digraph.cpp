@@ -0,0 +1,82 @@
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "chrono.hpp"
+
+#include "melon/container/static_digraph.hpp"
+#include "melon/utility/static_digraph_builder.hpp"
+
+#include "warm_up.hpp"
+#include "weakly_connected_components.hpp"
+
+using namespace fhamonic::melon;
+
+auto parse_gr(const std::filesystem::path & file_name) {
+    std::ifstream gr_file(file_name);
+    std::size_t nb_nodes, nb_arcs;
+    gr_file >> nb_nodes >> nb_arcs;
+
+    static_digraph_builder<static_digraph> builder(nb_nodes);
+
+    vertex_t<static_digraph> from, to;
+    while(gr_file >> from >> to) builder.add_arc(from, to);
+
+    return builder.build();
+}
+
+// Runs the kernel with each thread count, the first sequential run giving
+// the reference labels when reference is empty. The copy of the graph by
+// the constructor is not timed.
+template <wcc_kernel Kernel>
+void benchmark_kernel(const std::filesystem::path & gr_file,
+                      const static_digraph & graph, const std::string & name,
+                      const std::vector<std::size_t> & nb_threads_list,
+                      std::vector<std::uint32_t> & reference) {
+    for(const std::size_t nb_threads : nb_threads_list) {
+        weakly_connected_components<static_digraph, Kernel> wcc(graph,
+                                                                nb_threads);
+        Chrono chrono;
+        wcc.run();
+        const double time_ms = chrono.timeUs() / 1000.0;
+
+        if(reference.empty())
+            reference.assign(wcc.labels().begin(), wcc.labels().end());
+        const bool same_labels =
+            std::ranges::equal(wcc.labels(), reference);
+
+        std::cout << gr_file.stem() << ',' << graph.nb_vertices() << ','
+                  << graph.nb_arcs() << ',' << name << ',' << wcc.nb_threads()
+                  << ',' << wcc.nb_components() << ',' << time_ms << ','
+                  << same_labels << std::endl;
+    }
+}
+
+int main() {
+    std::vector<std::filesystem::path> gr_files(
+        {"data/web-Stanford.txt", "data/Amazon0505.txt", "data/WikiTalk.txt"});
+    const std::vector<std::size_t> nb_threads_list = {1, 2, 4, 8, 16};
+
+    std::cout << "instance,nb_nodes,nb_arcs,kernel,nb_threads,nb_components,"
+                 "time_ms,same_labels\n";
+
+    (void)warm_up();
+
+    for(const auto & gr_file : gr_files) {
+        auto [graph] = parse_gr(gr_file);
+
+        std::vector<std::uint32_t> reference;
+        benchmark_kernel<wcc_kernel::union_find>(gr_file, graph, "union_find",
+                                                 {1}, reference);
+        benchmark_kernel<wcc_kernel::label_propagation>(
+            gr_file, graph, "label_propagation", nb_threads_list, reference);
+        benchmark_kernel<wcc_kernel::afforest>(gr_file, graph, "afforest",
+                                               nb_threads_list, reference);
+    }
+    return 0;
+}
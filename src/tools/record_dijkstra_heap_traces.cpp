@@ -0,0 +1,71 @@
+#include <filesystem>
+#include <iostream>
+
+#include "melon/algorithm/dijkstra.hpp"
+#include "melon/container/static_digraph.hpp"
+
+#include "heap_trace.hpp"
+#include "melon_parsers.hpp"
+
+using namespace fhamonic::melon;
+
+struct dijkstra_traits {
+    using semiring = shortest_path_semiring<unsigned int>;
+    using heap = tracing_heap<d_ary_heap<
+        2, vertex_t<static_digraph>, unsigned int,
+        decltype([](const auto & e1, const auto & e2) {
+            return semiring::less(e1.second, e2.second);
+        }),
+        vertex_map_t<static_digraph, std::size_t>>>;
+
+    static constexpr bool store_paths = false;
+    static constexpr bool store_distances = false;
+};
+
+// Records the heap operations of Dijkstra runs from nb_runs evenly spaced
+// sources on each DIMACS instance, replayed by the heap-replay benchmarks
+int main() {
+    std::vector<std::filesystem::path> gr_files(
+        {"data/9th_DIMACS_USA_roads/distance/USA-road-d.NY.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NY.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.BAY.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.BAY.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.COL.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.COL.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.FLA.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.FLA.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.NW.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NW.gr",
+         "data/9th_DIMACS_USA_roads/distance/USA-road-d.NE.gr",
+         "data/9th_DIMACS_USA_roads/time/USA-road-t.NE.gr"});
+    const std::filesystem::path traces_dir("traces/dijkstra");
+    const std::size_t nb_runs = 3;
+
+    std::filesystem::create_directories(traces_dir);
+    std::cout << "instance,nb_nodes,nb_arcs,nb_runs,nb_operations\n";
+
+    for(const auto & gr_file : gr_files) {
+        auto [graph, length_map] =
+            parse_melon_weighted_digraph<static_digraph, unsigned int>(
+                gr_file);
+        const std::size_t nb_nodes = graph.nb_vertices();
+
+        heap_trace & trace = dijkstra_traits::heap::trace;
+        trace.nb_ids = nb_nodes;
+        trace.operations.clear();
+        for(std::size_t i = 0; i < nb_runs; ++i) {
+            if(i > 0)
+                trace.operations.push_back({heap_operation_type::clear, 0, 0});
+            const vertex_t<static_digraph> s =
+                static_cast<vertex_t<static_digraph>>(i * nb_nodes / nb_runs);
+            dijkstra algo(dijkstra_traits{}, graph, length_map, s);
+            algo.run();
+        }
+
+        write_heap_trace(traces_dir / gr_file.stem().concat(".trace"), trace);
+        std::cout << gr_file.stem() << ',' << nb_nodes << ','
+                  << graph.nb_arcs() << ',' << nb_runs << ','
+                  << trace.operations.size() << std::endl;
+    }
+    return 0;
+}